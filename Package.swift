@@ -78,7 +78,9 @@ let package = Package(
             name: "USDInteropTests",
             dependencies: [
                 "USDInterop",
-                "USDOperations"
+                "USDInteropCxx",
+                "USDOperations",
+                .product(name: "OpenUSD", package: "SwiftUsd")
             ],
             swiftSettings: [
                 .interoperabilityMode(.Cxx)
@@ -149,6 +149,35 @@ public enum USDInteropOpenUSDShim {
         USDInteropCxx.USDInterop.BlockAttribute(attr)
     }
 
+    /// Applies many attribute edits in one crossing and one change block.
+    /// Returns one `AttributeEditStatusCxx` raw value per edit.
+    @inline(__always)
+    public static func applyAttributeEdits(
+        _ stage: pxrInternal_v0_26_3__pxrReserved__.UsdStage,
+        _ edits: USDInteropCxx.USDInterop.AttributeEditListCxx
+    ) -> [UInt8] {
+        Array(USDInteropCxx.USDInterop.ApplyAttributeEdits(stage, edits))
+    }
+
+    /// Runs `body` and returns how many `ObjectsChanged` notices `stage`
+    /// sent meanwhile, or nil when counting could not start.
+    public static func countObjectsChanged(
+        _ stage: pxrInternal_v0_26_3__pxrReserved__.UsdStage,
+        during body: () throws -> Void
+    ) rethrows -> Int? {
+        let id = USDInteropCxx.USDInterop.BeginObjectsChangedCount(stage)
+        guard id >= 0 else {
+            return nil
+        }
+        do {
+            try body()
+        } catch {
+            _ = USDInteropCxx.USDInterop.EndObjectsChangedCount(id)
+            throw error
+        }
+        return Int(USDInteropCxx.USDInterop.EndObjectsChangedCount(id))
+    }
+
     @inline(__always)
     public static func disconnectShadeInput(
         _ input: pxrInternal_v0_26_3__pxrReserved__.UsdShadeInput
@@ -198,6 +227,16 @@ public enum USDInteropOpenUSDShim {
     ) -> Bool {
         USDInteropCxx.USDInterop.ExportStage(stage, std.string(path), addSourceFileComment)
     }
+
+    /// Native stage statistics for a stage already opened from Swift.
+    public static func stageStatistics(
+        _ stage: pxrInternal_v0_26_3__pxrReserved__.UsdStage,
+        options: USDInteropStageStats.Options = .all
+    ) -> USDInteropStageStats? {
+        USDInteropStageStats(
+            consuming: USDInteropCxx.USDInterop.GetStageStatistics(stage, options.rawValue)
+        )
+    }
 }
 
 public enum USDInteropAttributeReader {
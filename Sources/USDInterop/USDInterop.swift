@@ -49,6 +49,45 @@ public enum USDInteropStage {
 		}
 	}
 
+	/// One page of a prim's children, expanded `depth` levels, read from the
+	/// file's cached stage. `limit` of 0 returns every child.
+	public static func sceneGraphChildrenJSON(
+		url: URL,
+		primPath: String,
+		depth: Int = 1,
+		offset: Int = 0,
+		limit: Int = 0
+	) -> String? {
+		url.path.withCString { pathPointer in
+			primPath.withCString { primPointer in
+				guard let result = usdinterop_scene_graph_children_json(
+					pathPointer,
+					primPointer,
+					Int32(clamping: depth),
+					max(0, offset),
+					max(0, limit)
+				) else {
+					return nil
+				}
+				defer { usdinterop_free_string(result) }
+				return String(cString: result)
+			}
+		}
+	}
+
+	/// Compact struct-of-arrays scene graph; avoids producing and re-parsing JSON.
+	public static func sceneGraph(url: URL) -> USDInteropSceneGraph? {
+		sceneGraph(path: url.path)
+	}
+
+	public static func sceneGraph(path: String) -> USDInteropSceneGraph? {
+		var size = 0
+		let block = path.withCString { pointer in
+			usdinterop_scene_graph_binary(pointer, &size)
+		}
+		return USDInteropSceneGraph(block: block, byteCount: size)
+	}
+
 	/// Scene bounds with min, max, center and maxExtent
 	public struct SceneBounds {
 		public var min: SIMD3<Float>
@@ -66,10 +105,39 @@ public enum USDInteropStage {
 		let result = path.withCString { pointer in
 			usdinterop_scene_bounds(pointer)
 		}
+		return SceneBounds(result)
+	}
+
+	/// Strategies that produced a fast bounds result.
+	public struct BoundsStrategies: OptionSet, Sendable {
+		public let rawValue: Int32
+		public init(rawValue: Int32) { self.rawValue = rawValue }
+
+		public static let extentsHint = BoundsStrategies(rawValue: Int32(USDINTEROP_BOUNDS_EXTENTS_HINT))
+		public static let authoredExtent = BoundsStrategies(rawValue: Int32(USDINTEROP_BOUNDS_AUTHORED_EXTENT))
+		public static let computedExtent = BoundsStrategies(rawValue: Int32(USDINTEROP_BOUNDS_COMPUTED_EXTENT))
+		public static let loadedPayload = BoundsStrategies(rawValue: Int32(USDINTEROP_BOUNDS_LOADED_PAYLOAD))
+	}
+
+	/// Framing bounds read from authored `extentsHint`/`extent` without
+	/// loading payloads, plus the strategies that produced them.
+	public static func fastSceneBounds(url: URL) -> (bounds: SceneBounds, strategies: BoundsStrategies)? {
+		let result = url.path.withCString { pointer in
+			usdinterop_scene_bounds_fast(pointer)
+		}
+		guard let bounds = SceneBounds(result.bounds) else {
+			return nil
+		}
+		return (bounds, BoundsStrategies(rawValue: result.strategies))
+	}
+}
+
+extension USDInteropStage.SceneBounds {
+	init?(_ result: USDInteropBounds) {
 		guard result.hasGeometry != 0 else {
 			return nil
 		}
-		return SceneBounds(
+		self.init(
 			min: SIMD3(result.minX, result.minY, result.minZ),
 			max: SIMD3(result.maxX, result.maxY, result.maxZ),
 			center: SIMD3(result.centerX, result.centerY, result.centerZ),
@@ -78,6 +146,491 @@ public enum USDInteropStage {
 	}
 }
 
+/// Retained handle to a stage composed through the native LRU stage cache.
+/// Opening the same file again reuses the composed stage, reloading only the
+/// layers whose files changed, so repeated queries against one document skip
+/// recomposition.
+public final class USDInteropStageHandle: @unchecked Sendable {
+	public enum LoadSet: Sendable {
+		case all
+		case none
+
+		var cValue: USDInteropLoadSet {
+			switch self {
+			case .all: return USDINTEROP_LOAD_ALL
+			case .none: return USDINTEROP_LOAD_NONE
+			}
+		}
+	}
+
+	let pointer: OpaquePointer
+
+	public convenience init?(url: URL, loadSet: LoadSet = .all) {
+		self.init(path: url.path, loadSet: loadSet)
+	}
+
+	public init?(path: String, loadSet: LoadSet = .all) {
+		let opened = path.withCString { pointer in
+			usdinterop_stage_open(pointer, loadSet.cValue)
+		}
+		guard let opened else {
+			return nil
+		}
+		self.pointer = opened
+	}
+
+	deinit {
+		usdinterop_stage_release(pointer)
+	}
+
+	/// Reloads layers that changed on disk. Returns the number of layers
+	/// reloaded, or nil when a reload failed or this runs inside a native
+	/// query callback. Reloaded layers change for every stage sharing them, so
+	/// do not call this, or open a changed file, while stages opened through
+	/// `USDInteropOpenUSDShim` are being read on another thread.
+	@discardableResult
+	public func refresh() -> Int? {
+		let reloaded = usdinterop_stage_refresh(pointer)
+		return reloaded < 0 ? nil : Int(reloaded)
+	}
+
+	public func exportUSDA() -> String? {
+		guard let result = usdinterop_export_usda_for_stage(pointer) else {
+			return nil
+		}
+		defer { usdinterop_free_string(result) }
+		return String(cString: result)
+	}
+
+	public func sceneGraphJSON() -> String? {
+		guard let result = usdinterop_scene_graph_json_for_stage(pointer) else {
+			return nil
+		}
+		defer { usdinterop_free_string(result) }
+		return String(cString: result)
+	}
+
+	/// Streams the scene graph JSON in fixed-size chunks. Return `false` from
+	/// `body` to stop early.
+	@discardableResult
+	public func writeSceneGraphJSON(_ body: (UnsafeRawBufferPointer) -> Bool) -> Bool {
+		withoutActuallyEscaping(body) { escapable in
+			var sink = escapable
+			return withUnsafeMutablePointer(to: &sink) { context in
+				usdinterop_scene_graph_json_write(pointer, { data, size, context in
+					guard let context else { return 1 }
+					let body = context.assumingMemoryBound(
+						to: ((UnsafeRawBufferPointer) -> Bool).self
+					).pointee
+					return body(UnsafeRawBufferPointer(start: data, count: size)) ? 0 : 1
+				}, context) != 0
+			}
+		}
+	}
+
+	/// Streams the scene graph JSON straight into an open file.
+	@discardableResult
+	public func writeSceneGraphJSON(to fileHandle: FileHandle) -> Bool {
+		usdinterop_scene_graph_json_write_fd(pointer, fileHandle.fileDescriptor) != 0
+	}
+
+	public func sceneGraphChildrenJSON(
+		primPath: String,
+		depth: Int = 1,
+		offset: Int = 0,
+		limit: Int = 0
+	) -> String? {
+		primPath.withCString { primPointer in
+			guard let result = usdinterop_scene_graph_children_json_for_stage(
+				pointer,
+				primPointer,
+				Int32(clamping: depth),
+				max(0, offset),
+				max(0, limit)
+			) else {
+				return nil
+			}
+			defer { usdinterop_free_string(result) }
+			return String(cString: result)
+		}
+	}
+
+	public func sceneGraph() -> USDInteropSceneGraph? {
+		var size = 0
+		let block = usdinterop_scene_graph_binary_for_stage(pointer, &size)
+		return USDInteropSceneGraph(block: block, byteCount: size)
+	}
+
+	public func sceneBounds() -> USDInteropStage.SceneBounds? {
+		USDInteropStage.SceneBounds(usdinterop_scene_bounds_for_stage(pointer))
+	}
+
+	/// One subtree's share of a fast bounds result.
+	public struct BoundContribution: Sendable {
+		public let primPath: String
+		public let strategy: USDInteropStage.BoundsStrategies
+		/// World-space range; `min > max` when the subtree was empty.
+		public let min: SIMD3<Float>
+		public let max: SIMD3<Float>
+	}
+
+	/// Payload-free framing bounds plus the strategy that bounded each
+	/// contributing subtree.
+	public func fastBounds() -> (bounds: USDInteropStage.SceneBounds?, contributions: [BoundContribution]) {
+		let detail = usdinterop_scene_bounds_fast_detail_for_stage(pointer)
+		defer { usdinterop_free_fast_bounds_detail(detail) }
+		let contributions = (0..<Int(detail.contributionCount)).compactMap { index -> BoundContribution? in
+			guard let contribution = detail.contributions?[index], let path = contribution.primPath else {
+				return nil
+			}
+			let range = contribution.range
+			return BoundContribution(
+				primPath: String(cString: path),
+				strategy: USDInteropStage.BoundsStrategies(rawValue: contribution.strategy),
+				min: SIMD3(range.0, range.1, range.2),
+				max: SIMD3(range.3, range.4, range.5)
+			)
+		}
+		return (USDInteropStage.SceneBounds(detail.summary.bounds), contributions)
+	}
+
+	/// World bounds for every prim at every time code (`nil` = default time),
+	/// as 6 floats per pair (min xyz, max xyz), time-major. Empty bounds have
+	/// `min > max`.
+	public func bounds(primPaths: [String], timeCodes: [Double]? = nil) -> [Float]? {
+		let timeCount = timeCodes?.count ?? 1
+		var output = [Float](repeating: 0, count: primPaths.count * timeCount * 6)
+		let status = withCStringArray(primPaths) { paths in
+			output.withUnsafeMutableBufferPointer { buffer in
+				if let timeCodes {
+					return timeCodes.withUnsafeBufferPointer { times in
+						usdinterop_compute_bounds_batch(
+							pointer, paths, primPaths.count, times.baseAddress, timeCount, buffer.baseAddress
+						)
+					}
+				}
+				return usdinterop_compute_bounds_batch(
+					pointer, paths, primPaths.count, nil, 0, buffer.baseAddress
+				)
+			}
+		}
+		return status < 0 ? nil : output
+	}
+
+	/// Dense samples of several attributes over a frame range.
+	public struct AttributeSamples: Sendable {
+		public let times: [Double]
+		/// Components per sample for each attribute; 0 when it was not sampled.
+		public let componentCounts: [Int]
+		/// One column per attribute, `times.count * componentCounts[i]` values
+		/// long, with NaN where the attribute has no value.
+		public let columns: [[Double]]
+	}
+
+	/// Samples `attributePaths` from `start` through `end` every `stride`
+	/// frames in one native call.
+	public func sampleAttributes(
+		_ attributePaths: [String],
+		start: Double,
+		end: Double,
+		stride: Double = 1
+	) -> AttributeSamples? {
+		let samples = withCStringArray(attributePaths) { paths in
+			usdinterop_sample_attributes(pointer, paths, attributePaths.count, start, end, stride)
+		}
+		guard let times = samples.times else {
+			return nil
+		}
+		defer { usdinterop_free_attribute_samples(samples) }
+
+		let frameCount = Int(samples.frameCount)
+		let componentCounts = (0..<Int(samples.attributeCount)).map { Int(samples.componentCounts[$0]) }
+		let columns = componentCounts.enumerated().map { index, components in
+			let start = samples.values + Int(samples.columnOffsets[index])
+			return Array(UnsafeBufferPointer(start: start, count: frameCount * components))
+		}
+		return AttributeSamples(
+			times: Array(UnsafeBufferPointer(start: times, count: frameCount)),
+			componentCounts: componentCounts,
+			columns: columns
+		)
+	}
+
+	/// One authored opinion returned by `sourceSites(paths:)`. `role` and
+	/// `kind` carry the raw `USDInteropSourceSite` values.
+	public struct SourceSite: Sendable {
+		public let layerIdentifier: String
+		public let layerRealPath: String?
+		public let specPath: String?
+		public let role: Int32
+		public let kind: Int32
+	}
+
+	/// Strength-ordered source sites for many prim and property paths in one
+	/// native call. Results line up with `paths`; paths not on the stage get
+	/// an empty list.
+	public func sourceSites(paths: [String]) -> [[SourceSite]] {
+		guard !paths.isEmpty else {
+			return []
+		}
+		let batch = withCStringArray(paths) { pointers in
+			usdinterop_source_sites_batch(pointer, pointers, paths.count)
+		}
+		defer { usdinterop_free_source_site_batch(batch) }
+		guard let firstSites = batch.firstSites,
+			let siteCounts = batch.siteCounts,
+			let sites = batch.sites,
+			let layerTable = batch.layers
+		else {
+			return Array(repeating: [], count: paths.count)
+		}
+
+		// Layer strings are shared across sites, so convert each one once.
+		let layers = (0..<Int(batch.layerCount)).map { index in
+			let layer = layerTable[index]
+			return (
+				identifier: layer.identifier.map { String(cString: $0) } ?? "",
+				realPath: layer.realPath.map { String(cString: $0) }
+			)
+		}
+		return (0..<Int(batch.pathCount)).map { path in
+			let first = Int(firstSites[path])
+			return (first..<first + Int(siteCounts[path])).map { index in
+				let site = sites[index]
+				let layer = layers[Int(site.layerIndex)]
+				return SourceSite(
+					layerIdentifier: layer.identifier,
+					layerRealPath: layer.realPath,
+					specPath: site.specPath.map { String(cString: $0) },
+					role: site.role,
+					kind: site.kind
+				)
+			}
+		}
+	}
+
+	/// Counts prims by type, meshes, materials and instances in one native pass.
+	/// Leave out options to skip the work behind them; camera and animation
+	/// paths are always listed.
+	public func statistics(options: USDInteropStageStats.Options = .all) -> USDInteropStageStats? {
+		USDInteropStageStats(consuming: usdinterop_stage_statistics_with_options(pointer, options.rawValue))
+	}
+
+	/// Sets how many composed stages the native cache keeps. Zero disables caching.
+	public static func setCacheCapacity(_ capacity: Int) {
+		usdinterop_stage_cache_set_capacity(max(0, capacity))
+	}
+
+	public static func clearCache() {
+		usdinterop_stage_cache_clear()
+	}
+}
+
+/// Stage-wide counts copied out of a native `USDInteropStageStatistics` block.
+public struct USDInteropStageStats: Sendable {
+	public var primCount = 0
+	public var meshCount = 0
+	public var meshPointCount = 0
+	public var meshFaceCount = 0
+	public var meshFaceVertexCount = 0
+	public var meshPrimvarCount = 0
+	public var materialCount = 0
+	public var instanceCount = 0
+	public var prototypeCount = 0
+	public var layerCount = 0
+	public var layerByteEstimate = 0
+	/// Prim counts by type name, most common first. Untyped prims use "".
+	public var typeCounts: [(typeName: String, count: Int)] = []
+	/// Prims typed exactly `Camera`.
+	public var cameraPaths: [String] = []
+	public var animationPaths: [String] = []
+
+	/// Optional parts of the statistics pass. Unrequested counts stay zero.
+	public struct Options: OptionSet, Sendable {
+		public let rawValue: UInt32
+		public init(rawValue: UInt32) { self.rawValue = rawValue }
+
+		/// Mesh and material totals; reads every mesh's points and face counts.
+		public static let meshes = Options(rawValue: UInt32(USDINTEROP_STATISTICS_MESHES))
+		/// Prims inside instancing prototypes.
+		public static let prototypes = Options(rawValue: UInt32(USDINTEROP_STATISTICS_PROTOTYPES))
+		/// Layer count and size estimate; opens every used layer's asset.
+		public static let layers = Options(rawValue: UInt32(USDINTEROP_STATISTICS_LAYERS))
+		public static let all: Options = [.meshes, .prototypes, .layers]
+	}
+
+	/// Copies and frees a block from `usdinterop_stage_statistics`.
+	init?(consuming block: UnsafeMutablePointer<USDInteropStageStatistics>?) {
+		guard let block else {
+			return nil
+		}
+		defer { usdinterop_free_stage_statistics(block) }
+
+		let native = block.pointee
+		primCount = Int(native.primCount)
+		meshCount = Int(native.meshCount)
+		meshPointCount = Int(native.meshPointCount)
+		meshFaceCount = Int(native.meshFaceCount)
+		meshFaceVertexCount = Int(native.meshFaceVertexCount)
+		meshPrimvarCount = Int(native.meshPrimvarCount)
+		materialCount = Int(native.materialCount)
+		instanceCount = Int(native.instanceCount)
+		prototypeCount = Int(native.prototypeCount)
+		layerCount = Int(native.layerCount)
+		layerByteEstimate = Int(native.layerByteEstimate)
+		typeCounts = (0..<Int(native.typeCountCount)).map { index in
+			let entry = native.typeCounts[index]
+			return (String(cString: entry.typeName), Int(entry.count))
+		}
+		cameraPaths = (0..<Int(native.cameraCount)).compactMap { index in
+			native.cameraPaths[index].map { String(cString: $0) }
+		}
+		animationPaths = (0..<Int(native.animationCount)).compactMap { index in
+			native.animationPaths[index].map { String(cString: $0) }
+		}
+	}
+}
+
+/// Finds prims by type, kind, applied API schema or name prefix without
+/// traversing the stage. The index follows edits, payload loads and
+/// `USDInteropStageHandle.refresh()` by reindexing only the changed subtrees.
+public final class USDInteropPrimIndex: @unchecked Sendable {
+	private let pointer: OpaquePointer
+
+	public init?(stage: USDInteropStageHandle) {
+		guard let created = usdinterop_prim_index_create(stage.pointer) else {
+			return nil
+		}
+		self.pointer = created
+	}
+
+	deinit {
+		usdinterop_prim_index_destroy(pointer)
+	}
+
+	/// Prims whose schema type is `typeName` or derives from it.
+	public func prims(ofType typeName: String, limit: Int = 0) -> [String] {
+		query(USDINTEROP_PRIM_INDEX_TYPE, typeName, limit: limit)
+	}
+
+	public func prims(ofKind kind: String, limit: Int = 0) -> [String] {
+		query(USDINTEROP_PRIM_INDEX_KIND, kind, limit: limit)
+	}
+
+	public func prims(withAPISchema schema: String, limit: Int = 0) -> [String] {
+		query(USDINTEROP_PRIM_INDEX_API_SCHEMA, schema, limit: limit)
+	}
+
+	/// Prims whose name starts with `prefix`, ignoring ASCII case.
+	public func prims(namePrefix prefix: String, limit: Int = 0) -> [String] {
+		query(USDINTEROP_PRIM_INDEX_NAME_PREFIX, prefix, limit: limit)
+	}
+
+	private func query(_ key: USDInteropPrimIndexKey, _ value: String, limit: Int) -> [String] {
+		let list = value.withCString { pointer in
+			usdinterop_prim_index_query(self.pointer, key, pointer, max(limit, 0))
+		}
+		defer { usdinterop_free_string_list(list) }
+		guard let strings = list.strings else {
+			return []
+		}
+		return (0..<list.count).compactMap { index in
+			strings[index].map { String(cString: $0) }
+		}
+	}
+}
+
+/// Read-only view over the native binary scene graph. Prims are indexed in
+/// depth-first pre-order; lookups read directly from the native block.
+public final class USDInteropSceneGraph: @unchecked Sendable {
+	private let block: UnsafeRawPointer
+	private let header: USDInteropSceneGraphBinaryHeader
+	public let byteCount: Int
+
+	init?(block: UnsafeRawPointer?, byteCount: Int) {
+		guard let block else {
+			return nil
+		}
+		let header = block.load(as: USDInteropSceneGraphBinaryHeader.self)
+		guard header.magic == USDINTEROP_SCENE_GRAPH_BINARY_MAGIC,
+			header.version == USDINTEROP_SCENE_GRAPH_BINARY_VERSION,
+			Int(header.totalSize) == byteCount
+		else {
+			usdinterop_free_bytes(block)
+			return nil
+		}
+		self.block = block
+		self.header = header
+		self.byteCount = byteCount
+	}
+
+	deinit {
+		usdinterop_free_bytes(block)
+	}
+
+	public var primCount: Int {
+		Int(header.primCount)
+	}
+
+	/// Indices of the top-level prims, in authored order.
+	public var rootIndices: [Int] {
+		var indices: [Int] = []
+		var current: Int? = primCount > 0 ? 0 : nil
+		while let index = current {
+			indices.append(index)
+			current = nextSiblingIndex(of: index)
+		}
+		return indices
+	}
+
+	public func parentIndex(of prim: Int) -> Int? {
+		index(at: header.parentIndexOffset, prim: prim)
+	}
+
+	public func firstChildIndex(of prim: Int) -> Int? {
+		index(at: header.firstChildOffset, prim: prim)
+	}
+
+	public func nextSiblingIndex(of prim: Int) -> Int? {
+		index(at: header.nextSiblingOffset, prim: prim)
+	}
+
+	/// NUL-terminated prim name, valid for the lifetime of this scene graph.
+	public func nameCString(of prim: Int) -> UnsafePointer<CChar> {
+		let nameIndex = block.load(
+			fromByteOffset: Int(header.nameIndexOffset) + prim * MemoryLayout<UInt32>.stride,
+			as: UInt32.self
+		)
+		return string(at: Int(nameIndex))
+	}
+
+	public func name(of prim: Int) -> String {
+		String(cString: nameCString(of: prim))
+	}
+
+	public func typeName(of prim: Int) -> String? {
+		index(at: header.typeIndexOffset, prim: prim).map { String(cString: string(at: $0)) }
+	}
+
+	private func index(at arrayOffset: UInt64, prim: Int) -> Int? {
+		precondition(prim >= 0 && prim < primCount, "Prim index out of range")
+		let value = block.load(
+			fromByteOffset: Int(arrayOffset) + prim * MemoryLayout<Int32>.stride,
+			as: Int32.self
+		)
+		return value < 0 ? nil : Int(value)
+	}
+
+	private func string(at index: Int) -> UnsafePointer<CChar> {
+		let offset = block.load(
+			fromByteOffset: Int(header.stringOffsetsOffset) + index * MemoryLayout<UInt32>.stride,
+			as: UInt32.self
+		)
+		return (block + Int(header.stringDataOffset) + Int(offset))
+			.assumingMemoryBound(to: CChar.self)
+	}
+}
+
 public enum USDInteropPackagePaths {
 	private static func stringResult(
 		_ body: () -> UnsafePointer<CChar>?
@@ -149,28 +702,253 @@ public enum USDInteropPackagePaths {
 }
 
 public enum USDInteropAssets {
+	/// Reads an asset's contents. The returned `Data` wraps the native buffer
+	/// directly (memory-mapped for files and stored USDZ entries) and keeps the
+	/// asset open until the data is released.
 	public static func readData(assetPath: String, anchorAssetPath: String? = nil) -> Data? {
-		var byteCount: Int = 0
-		let dataPointer: UnsafePointer<UInt8>? = assetPath.withCString { assetPointer in
+		guard let asset = USDInteropAsset(assetPath: assetPath, anchorAssetPath: anchorAssetPath) else {
+			return nil
+		}
+		return asset.data
+	}
+
+	/// Resolves many asset paths against one anchor in a single native call.
+	/// Results line up with `assetPaths`; unresolved entries are nil.
+	public static func resolve(assetPaths: [String], anchorAssetPath: String? = nil) -> [String?] {
+		guard !assetPaths.isEmpty else {
+			return []
+		}
+		let list = withCStringArray(assetPaths) { paths in
+			if let anchorAssetPath {
+				return anchorAssetPath.withCString { anchorPointer in
+					usdinterop_resolve_batch(anchorPointer, paths, assetPaths.count)
+				}
+			}
+			return usdinterop_resolve_batch(nil, paths, assetPaths.count)
+		}
+		defer { usdinterop_free_string_list(list) }
+		guard let strings = list.strings else {
+			return Array(repeating: nil, count: assetPaths.count)
+		}
+		return (0..<list.count).map { index in
+			strings[index].map { String(cString: $0) }
+		}
+	}
+
+	/// Opens and buffers many assets concurrently against one anchor. Results
+	/// line up with `assetPaths`; entries that failed to resolve or read are nil.
+	public static func open(assetPaths: [String], anchorAssetPath: String? = nil) -> [USDInteropAsset?] {
+		guard !assetPaths.isEmpty else {
+			return []
+		}
+		var items = [USDInteropAssetBatchItem](repeating: USDInteropAssetBatchItem(), count: assetPaths.count)
+		withCStringArray(assetPaths) { paths in
+			items.withUnsafeMutableBufferPointer { buffer in
+				if let anchorAssetPath {
+					anchorAssetPath.withCString { anchorPointer in
+						_ = usdinterop_asset_open_batch(anchorPointer, paths, assetPaths.count, buffer.baseAddress)
+					}
+				} else {
+					_ = usdinterop_asset_open_batch(nil, paths, assetPaths.count, buffer.baseAddress)
+				}
+			}
+		}
+		return items.map { item in
+			item.asset.map { USDInteropAsset(pointer: $0) }
+		}
+	}
+}
+
+/// An asset opened through the Ar resolver. Contents are exposed without
+/// copying and stay valid for the life of the asset (or any `Data` from it).
+public final class USDInteropAsset: @unchecked Sendable {
+	let pointer: OpaquePointer
+
+	public init?(assetPath: String, anchorAssetPath: String? = nil) {
+		let opened: OpaquePointer? = assetPath.withCString { assetPointer in
 			if let anchorAssetPath {
 				return anchorAssetPath.withCString { anchorPointer in
-					var count: Int = 0
-					let pointer = usdinterop_read_asset_bytes(assetPointer, anchorPointer, &count)
-					byteCount = count
-					return pointer
+					usdinterop_asset_open(assetPointer, anchorPointer)
 				}
-			} else {
-				var count: Int = 0
-				let pointer = usdinterop_read_asset_bytes(assetPointer, nil, &count)
-				byteCount = count
-				return pointer
 			}
+			return usdinterop_asset_open(assetPointer, nil)
+		}
+		guard let opened else {
+			return nil
 		}
+		pointer = opened
+	}
+
+	init(pointer: OpaquePointer) {
+		self.pointer = pointer
+	}
+
+	deinit {
+		usdinterop_asset_close(pointer)
+	}
+
+	public var size: Int {
+		Int(usdinterop_asset_size(pointer))
+	}
 
-		guard let dataPointer else {
+	/// The asset's contents, backed by the native buffer.
+	public var data: Data? {
+		let count = size
+		if count == 0 {
+			return Data()
+		}
+		guard let bytes = usdinterop_asset_data(pointer) else {
 			return nil
 		}
-		defer { usdinterop_free_bytes(dataPointer) }
-		return Data(bytes: dataPointer, count: byteCount)
+		return Data(
+			bytesNoCopy: UnsafeMutableRawPointer(mutating: bytes),
+			count: count,
+			deallocator: .custom { _, _ in withExtendedLifetime(self) {} }
+		)
+	}
+
+	/// Reads `length` bytes at `offset` without buffering the whole asset.
+	public func read(offset: Int, length: Int) -> Data {
+		guard offset >= 0, length > 0 else {
+			return Data()
+		}
+		var data = Data(count: length)
+		let read = data.withUnsafeMutableBytes { buffer in
+			usdinterop_asset_read_range(pointer, offset, length, buffer.baseAddress)
+		}
+		data.count = read
+		return data
+	}
+
+	/// Calls `body` with consecutive chunks of at most `chunkSize` bytes,
+	/// reusing one buffer. Return `false` from `body` to stop early.
+	public func forEachChunk(
+		chunkSize: Int = 1 << 20,
+		_ body: (UnsafeRawBufferPointer) throws -> Bool
+	) rethrows {
+		let capacity = max(1, chunkSize)
+		let buffer = UnsafeMutableRawBufferPointer.allocate(byteCount: capacity, alignment: 16)
+		defer { buffer.deallocate() }
+
+		usdinterop_asset_seek(pointer, 0)
+		while true {
+			let read = usdinterop_asset_read_next(pointer, buffer.baseAddress, capacity)
+			if read == 0 {
+				return
+			}
+			guard try body(UnsafeRawBufferPointer(rebasing: buffer[0..<read])) else {
+				return
+			}
+		}
+	}
+}
+
+/// A numeric attribute or primvar array shared with OpenUSD. Reading points
+/// or indices through `withUnsafeBufferPointer` does not copy them.
+public final class USDInteropArray: @unchecked Sendable {
+	let pointer: OpaquePointer
+
+	/// Reads `attributePath` (for example `/Mesh.points`) at `timeCode`, or at
+	/// the default time when `timeCode` is nil.
+	public init?(stage: USDInteropStageHandle, attributePath: String, timeCode: Double? = nil) {
+		let opened: OpaquePointer? = attributePath.withCString { pathPointer in
+			withOptionalTimeCode(timeCode) { timePointer in
+				usdinterop_attribute_array_open(stage.pointer, pathPointer, timePointer)
+			}
+		}
+		guard let opened else {
+			return nil
+		}
+		pointer = opened
+	}
+
+	init(pointer: OpaquePointer) {
+		self.pointer = pointer
+	}
+
+	deinit {
+		usdinterop_array_release(pointer)
+	}
+
+	/// Reads a primvar and, for indexed primvars, its index array. Values are
+	/// not flattened.
+	public static func primvar(
+		stage: USDInteropStageHandle,
+		primPath: String,
+		name: String,
+		timeCode: Double? = nil
+	) -> (values: USDInteropArray, indices: USDInteropArray?)? {
+		var indices: OpaquePointer?
+		let values: OpaquePointer? = primPath.withCString { pathPointer in
+			name.withCString { namePointer in
+				withOptionalTimeCode(timeCode) { timePointer in
+					usdinterop_primvar_array_open(stage.pointer, pathPointer, namePointer, timePointer, &indices)
+				}
+			}
+		}
+		guard let values else {
+			return nil
+		}
+		return (USDInteropArray(pointer: values), indices.map(USDInteropArray.init(pointer:)))
+	}
+
+	public var count: Int {
+		Int(usdinterop_array_view(pointer).count)
+	}
+
+	public var elementType: USDInteropArrayType {
+		usdinterop_array_view(pointer).type
+	}
+
+	/// Calls `body` with the elements viewed as `Element`, or returns nil when
+	/// `Element`'s stride does not match the array's element size. Use
+	/// `(Float, Float, Float)` for vec3f data (`SIMD3<Float>` is padded to 16
+	/// bytes), `SIMD2<Float>` for vec2f, `Int32` for int data, and so on.
+	public func withUnsafeBufferPointer<Element, Result>(
+		as _: Element.Type,
+		_ body: (UnsafeBufferPointer<Element>) throws -> Result
+	) rethrows -> Result? {
+		let view = usdinterop_array_view(pointer)
+		guard view.elementSize == MemoryLayout<Element>.stride else {
+			return nil
+		}
+		return try withExtendedLifetime(self) {
+			let base = view.data?.assumingMemoryBound(to: Element.self)
+			return try body(UnsafeBufferPointer(start: base, count: Int(view.count)))
+		}
+	}
+
+	/// Copies elements into `buffer`, starting at element `first`. Returns the
+	/// number of elements copied.
+	public func copy<Element>(into buffer: UnsafeMutableBufferPointer<Element>, from first: Int = 0) -> Int {
+		let view = usdinterop_array_view(pointer)
+		guard first >= 0, view.elementSize == MemoryLayout<Element>.stride else {
+			return 0
+		}
+		return Int(usdinterop_array_copy(pointer, first, buffer.count, buffer.baseAddress))
+	}
+}
+
+/// Calls `body` with a pointer to `timeCode`, or with nil for the default time.
+func withOptionalTimeCode<Result>(
+	_ timeCode: Double?,
+	_ body: (UnsafePointer<Double>?) -> Result
+) -> Result {
+	guard var timeCode else {
+		return body(nil)
+	}
+	return withUnsafePointer(to: &timeCode) { body($0) }
+}
+
+/// Calls `body` with a temporary C array of NUL-terminated copies of `strings`.
+func withCStringArray<Result>(
+	_ strings: [String],
+	_ body: (UnsafePointer<UnsafePointer<CChar>?>?) -> Result
+) -> Result {
+	let copies = strings.map { strdup($0) }
+	defer { copies.forEach { free($0) } }
+	let pointers = copies.map { $0.map { UnsafePointer($0) } }
+	return pointers.withUnsafeBufferPointer { buffer in
+		body(buffer.baseAddress)
 	}
 }
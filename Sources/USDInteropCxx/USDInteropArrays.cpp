@@ -0,0 +1,207 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/gf/half.h"
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/quatd.h"
+#include "pxr/base/gf/quatf.h"
+#include "pxr/base/gf/vec2d.h"
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec2i.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec3i.h"
+#include "pxr/base/gf/vec4d.h"
+#include "pxr/base/gf/vec4f.h"
+#include "pxr/base/gf/vec4i.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdGeom/primvar.h"
+#include "pxr/usd/usdGeom/primvarsAPI.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using USDInteropInternal::StageReadScope;
+
+struct usdinterop_array_s {
+  std::atomic<int> refCount{1};
+  // Shares the VtArray's storage; `data` points into it.
+  VtValue value;
+  const void *data = nullptr;
+  size_t count = 0;
+  size_t elementSize = 0;
+  USDInteropArrayType type = USDINTEROP_ARRAY_UNSUPPORTED;
+};
+
+namespace {
+UsdTimeCode TimeCodeOrDefault(const double *time_code) {
+  return time_code ? UsdTimeCode(*time_code) : UsdTimeCode::Default();
+}
+
+template <typename T>
+bool BindArray(usdinterop_array_s &array, USDInteropArrayType type) {
+  if (!array.value.IsHolding<VtArray<T>>()) {
+    return false;
+  }
+  // cdata() never detaches, so this is the same buffer the layer holds.
+  const VtArray<T> &elements = array.value.UncheckedGet<VtArray<T>>();
+  array.data = elements.cdata();
+  array.count = elements.size();
+  array.elementSize = sizeof(T);
+  array.type = type;
+  return true;
+}
+
+bool BindValue(usdinterop_array_s &array) {
+  return BindArray<GfVec3f>(array, USDINTEROP_ARRAY_VEC3F) ||
+         BindArray<int>(array, USDINTEROP_ARRAY_INT) ||
+         BindArray<GfVec2f>(array, USDINTEROP_ARRAY_VEC2F) ||
+         BindArray<float>(array, USDINTEROP_ARRAY_FLOAT) ||
+         BindArray<GfVec4f>(array, USDINTEROP_ARRAY_VEC4F) ||
+         BindArray<GfVec3d>(array, USDINTEROP_ARRAY_VEC3D) ||
+         BindArray<double>(array, USDINTEROP_ARRAY_DOUBLE) ||
+         BindArray<GfQuatf>(array, USDINTEROP_ARRAY_QUATF) ||
+         BindArray<GfMatrix4d>(array, USDINTEROP_ARRAY_MATRIX4D) ||
+         BindArray<bool>(array, USDINTEROP_ARRAY_BOOL) ||
+         BindArray<unsigned char>(array, USDINTEROP_ARRAY_UCHAR) ||
+         BindArray<unsigned int>(array, USDINTEROP_ARRAY_UINT) ||
+         BindArray<int64_t>(array, USDINTEROP_ARRAY_INT64) ||
+         BindArray<uint64_t>(array, USDINTEROP_ARRAY_UINT64) ||
+         BindArray<GfHalf>(array, USDINTEROP_ARRAY_HALF) ||
+         BindArray<GfVec2i>(array, USDINTEROP_ARRAY_VEC2I) ||
+         BindArray<GfVec3i>(array, USDINTEROP_ARRAY_VEC3I) ||
+         BindArray<GfVec4i>(array, USDINTEROP_ARRAY_VEC4I) ||
+         BindArray<GfVec2d>(array, USDINTEROP_ARRAY_VEC2D) ||
+         BindArray<GfVec4d>(array, USDINTEROP_ARRAY_VEC4D) ||
+         BindArray<GfQuatd>(array, USDINTEROP_ARRAY_QUATD);
+}
+
+usdinterop_array_t *MakeArrayHandle(VtValue &&value) {
+  auto *array = new usdinterop_array_s();
+  array->value = std::move(value);
+  if (!BindValue(*array)) {
+    delete array;
+    return nullptr;
+  }
+  return array;
+}
+} // namespace
+
+usdinterop_array_t *usdinterop_attribute_array_open(
+    const usdinterop_stage_t *stage,
+    const char *attribute_path,
+    const double *time_code) {
+  if (!attribute_path || attribute_path[0] == '\0') {
+    return nullptr;
+  }
+
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return nullptr;
+    }
+
+    const UsdAttribute attr =
+        usdStage->GetAttributeAtPath(SdfPath(attribute_path));
+    VtValue value;
+    if (!attr || !attr.Get(&value, TimeCodeOrDefault(time_code)) ||
+        !value.IsArrayValued()) {
+      return nullptr;
+    }
+    return MakeArrayHandle(std::move(value));
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+usdinterop_array_t *usdinterop_primvar_array_open(
+    const usdinterop_stage_t *stage,
+    const char *prim_path,
+    const char *primvar_name,
+    const double *time_code,
+    usdinterop_array_t **indices) {
+  if (indices) {
+    *indices = nullptr;
+  }
+  if (!prim_path || prim_path[0] == '\0' || !primvar_name ||
+      primvar_name[0] == '\0') {
+    return nullptr;
+  }
+
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return nullptr;
+    }
+
+    const UsdPrim prim = usdStage->GetPrimAtPath(SdfPath(prim_path));
+    if (!prim) {
+      return nullptr;
+    }
+    const UsdGeomPrimvar primvar =
+        UsdGeomPrimvarsAPI(prim).GetPrimvar(TfToken(primvar_name));
+    const UsdTimeCode time = TimeCodeOrDefault(time_code);
+    VtValue value;
+    if (!primvar || !primvar.Get(&value, time) || !value.IsArrayValued()) {
+      return nullptr;
+    }
+    usdinterop_array_t *values = MakeArrayHandle(std::move(value));
+    if (!values || !indices) {
+      return values;
+    }
+
+    VtIntArray indexArray;
+    if (primvar.IsIndexed() && primvar.GetIndices(&indexArray, time)) {
+      *indices = MakeArrayHandle(VtValue::Take(indexArray));
+    }
+    return values;
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+USDInteropArrayView usdinterop_array_view(const usdinterop_array_t *array) {
+  USDInteropArrayView view = {};
+  if (array) {
+    view.data = array->data;
+    view.count = array->count;
+    view.elementSize = array->elementSize;
+    view.type = array->type;
+  }
+  return view;
+}
+
+size_t usdinterop_array_copy(const usdinterop_array_t *array, size_t first,
+                             size_t count, void *dst) {
+  if (!array || !dst || first >= array->count) {
+    return 0;
+  }
+  const size_t copied = std::min(count, array->count - first);
+  std::memcpy(dst,
+              static_cast<const char *>(array->data) +
+                  first * array->elementSize,
+              copied * array->elementSize);
+  return copied;
+}
+
+usdinterop_array_t *usdinterop_array_retain(usdinterop_array_t *array) {
+  if (array) {
+    array->refCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  return array;
+}
+
+void usdinterop_array_release(usdinterop_array_t *array) {
+  if (!array) {
+    return;
+  }
+  if (array->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete array;
+  }
+}
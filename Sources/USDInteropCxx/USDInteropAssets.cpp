@@ -0,0 +1,377 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/ar/asset.h"
+#include "pxr/usd/ar/resolvedPath.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/ar/resolverScopedCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+/// An opened asset. The buffer is fetched on first access and retained for
+/// the life of the handle; for filesystem files and stored USDZ entries Ar
+/// backs it with a memory mapping, so exposing it costs no copy.
+struct usdinterop_asset_s {
+  std::shared_ptr<ArAsset> asset;
+  size_t size = 0;
+  // Position of the sequential reader used by `usdinterop_asset_read_next`.
+  size_t cursor = 0;
+  std::once_flag bufferOnce;
+  std::atomic<bool> buffered{false};
+  std::shared_ptr<const char> buffer;
+};
+
+namespace {
+const unsigned char *CopyToByteBuffer(const char *data, size_t size) {
+  if (!data && size != 0) {
+    return nullptr;
+  }
+
+  auto *buffer = static_cast<unsigned char *>(std::malloc(size == 0 ? 1 : size));
+  if (!buffer) {
+    return nullptr;
+  }
+
+  if (size != 0) {
+    std::memcpy(buffer, data, size);
+  }
+
+  return buffer;
+}
+
+/// Resolves `asset_path` against an optional anchor the way
+/// `usdinterop_read_asset_bytes` always has. Expects the resolver context for
+/// the anchor (or the asset itself) to be bound by the caller.
+ArResolvedPath ResolveAssetPath(ArResolver &resolver,
+                                const std::string &assetPath,
+                                const std::string &anchorAssetPath) {
+  const ArResolvedPath anchorResolvedPath =
+      !anchorAssetPath.empty() ? resolver.Resolve(anchorAssetPath)
+                               : ArResolvedPath();
+  const std::string identifier =
+      resolver.CreateIdentifier(assetPath, anchorResolvedPath);
+  return resolver.Resolve(identifier);
+}
+
+std::string AnchorOrEmpty(const char *anchor_asset_path) {
+  return (anchor_asset_path && anchor_asset_path[0] != '\0')
+             ? std::string(anchor_asset_path)
+             : std::string();
+}
+
+std::shared_ptr<ArAsset> OpenAsset(const char *asset_path,
+                                   const char *anchor_asset_path) {
+  ArResolver &resolver = ArGetResolver();
+
+  const std::string assetPath(asset_path);
+  const std::string anchorAssetPath = AnchorOrEmpty(anchor_asset_path);
+
+  const std::string contextAssetPath =
+      !anchorAssetPath.empty() ? anchorAssetPath : assetPath;
+  ArResolverContext context =
+      resolver.CreateDefaultContextForAsset(contextAssetPath);
+  ArResolverContextBinder binder(&resolver, context);
+
+  const ArResolvedPath resolvedPath =
+      ResolveAssetPath(resolver, assetPath, anchorAssetPath);
+  if (resolvedPath.empty()) {
+    return nullptr;
+  }
+  return resolver.OpenAsset(resolvedPath);
+}
+
+usdinterop_asset_t *MakeAssetHandle(std::shared_ptr<ArAsset> asset) {
+  auto *handle = new usdinterop_asset_t();
+  handle->size = asset->GetSize();
+  handle->asset = std::move(asset);
+  return handle;
+}
+
+/// Reads up to `length` bytes at `offset` into `dst` through `ArAsset::Read`,
+/// which pulls only that range from disk or from a stored USDZ entry. Uses
+/// the retained buffer instead when the contents were already mapped.
+size_t ReadAssetRange(usdinterop_asset_t *handle, size_t offset,
+                      size_t length, void *dst) {
+  if (offset >= handle->size || length == 0) {
+    return 0;
+  }
+  length = std::min(length, handle->size - offset);
+  const char *buffer =
+      handle->buffered.load(std::memory_order_acquire) ? handle->buffer.get()
+                                                       : nullptr;
+  if (buffer) {
+    std::memcpy(dst, buffer + offset, length);
+    return length;
+  }
+  try {
+    return handle->asset->Read(dst, length, offset);
+  } catch (...) {
+    return 0;
+  }
+}
+
+/// Returns the retained buffer, fetching it on first use. Null only when Ar
+/// could not produce a buffer for a non-empty asset.
+const char *AssetBuffer(usdinterop_asset_t *handle) {
+  std::call_once(handle->bufferOnce, [handle]() {
+    try {
+      handle->buffer = handle->asset->GetBuffer();
+    } catch (...) {
+      handle->buffer.reset();
+    }
+    handle->buffered.store(true, std::memory_order_release);
+  });
+  return handle->buffer.get();
+}
+} // namespace
+
+usdinterop_asset_t *usdinterop_asset_open(const char *asset_path,
+                                          const char *anchor_asset_path) {
+  if (!asset_path || asset_path[0] == '\0') {
+    return nullptr;
+  }
+
+  try {
+    std::shared_ptr<ArAsset> asset = OpenAsset(asset_path, anchor_asset_path);
+    if (!asset) {
+      return nullptr;
+    }
+
+    return MakeAssetHandle(std::move(asset));
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+size_t usdinterop_asset_size(const usdinterop_asset_t *asset) {
+  return asset ? asset->size : 0;
+}
+
+const void *usdinterop_asset_data(usdinterop_asset_t *asset) {
+  if (!asset) {
+    return nullptr;
+  }
+  return AssetBuffer(asset);
+}
+
+size_t usdinterop_asset_read_range(usdinterop_asset_t *asset, size_t offset,
+                                   size_t length, void *dst) {
+  if (!asset || !dst) {
+    return 0;
+  }
+  return ReadAssetRange(asset, offset, length, dst);
+}
+
+size_t usdinterop_asset_read_next(usdinterop_asset_t *asset, void *dst,
+                                  size_t capacity) {
+  if (!asset || !dst) {
+    return 0;
+  }
+  const size_t read = ReadAssetRange(asset, asset->cursor, capacity, dst);
+  asset->cursor += read;
+  return read;
+}
+
+void usdinterop_asset_seek(usdinterop_asset_t *asset, size_t offset) {
+  if (asset) {
+    asset->cursor = std::min(offset, asset->size);
+  }
+}
+
+size_t usdinterop_asset_tell(const usdinterop_asset_t *asset) {
+  return asset ? asset->cursor : 0;
+}
+
+void usdinterop_asset_close(usdinterop_asset_t *asset) {
+  delete asset;
+}
+
+const unsigned char *usdinterop_read_asset_bytes(const char *asset_path,
+                                                 const char *anchor_asset_path,
+                                                 size_t *size) {
+  if (!asset_path || asset_path[0] == '\0' || !size) {
+    return nullptr;
+  }
+
+  *size = 0;
+
+  usdinterop_asset_t *asset =
+      usdinterop_asset_open(asset_path, anchor_asset_path);
+  if (!asset) {
+    return nullptr;
+  }
+
+  const char *data = AssetBuffer(asset);
+  const unsigned char *copied =
+      (data || asset->size == 0) ? CopyToByteBuffer(data, asset->size)
+                                 : nullptr;
+  if (copied) {
+    *size = asset->size;
+  }
+  usdinterop_asset_close(asset);
+  return copied;
+}
+
+int usdinterop_asset_open_batch(const char *anchor_asset_path,
+                                const char *const *asset_paths,
+                                size_t asset_count,
+                                USDInteropAssetBatchItem *results) {
+  if (!asset_paths || asset_count == 0 || !results) {
+    return 0;
+  }
+
+  for (size_t index = 0; index < asset_count; ++index) {
+    results[index].status = USDINTEROP_ASSET_UNRESOLVED;
+    results[index].asset = nullptr;
+  }
+
+  try {
+    ArResolver &resolver = ArGetResolver();
+    const std::string anchorAssetPath = AnchorOrEmpty(anchor_asset_path);
+    const bool anchored = !anchorAssetPath.empty();
+
+    // With an anchor, one context, one resolved anchor and one resolve cache
+    // serve the whole batch, matching what each single-asset call derives
+    // from that anchor. Without one, each path gets the context a single
+    // call would create for it, and no cache is shared across contexts.
+    const ArResolverContext context =
+        anchored ? resolver.CreateDefaultContextForAsset(anchorAssetPath)
+                 : ArResolverContext();
+    std::optional<ArResolverContextBinder> binder;
+    std::optional<ArResolverScopedCache> batchCache;
+    ArResolvedPath anchorResolvedPath;
+    if (anchored) {
+      binder.emplace(&resolver, context);
+      batchCache.emplace();
+      anchorResolvedPath = resolver.Resolve(anchorAssetPath);
+    }
+
+    std::atomic<int> openedCount{0};
+    WorkParallelForN(asset_count, [&](size_t begin, size_t end) {
+      // Resolver caches and context bindings are per thread; workers bind
+      // the shared context themselves and reach the cache through a child.
+      std::optional<ArResolverScopedCache> workerCache;
+      std::optional<ArResolverContextBinder> workerBinder;
+      if (anchored) {
+        workerCache.emplace(&*batchCache);
+        workerBinder.emplace(&resolver, context);
+      }
+
+      for (size_t index = begin; index < end; ++index) {
+        USDInteropAssetBatchItem &item = results[index];
+        const char *assetPath = asset_paths[index];
+        if (!assetPath || assetPath[0] == '\0') {
+          continue;
+        }
+        try {
+          std::optional<ArResolverContextBinder> itemBinder;
+          if (!anchored) {
+            itemBinder.emplace(
+                &resolver, resolver.CreateDefaultContextForAsset(assetPath));
+          }
+          const ArResolvedPath resolvedPath = resolver.Resolve(
+              resolver.CreateIdentifier(assetPath, anchorResolvedPath));
+          if (resolvedPath.empty()) {
+            continue;
+          }
+          std::shared_ptr<ArAsset> asset = resolver.OpenAsset(resolvedPath);
+          if (!asset) {
+            item.status = USDINTEROP_ASSET_OPEN_FAILED;
+            continue;
+          }
+          usdinterop_asset_t *handle = MakeAssetHandle(std::move(asset));
+          // Buffer here so the reads overlap instead of happening one by one
+          // when the caller walks the results.
+          if (!AssetBuffer(handle) && handle->size != 0) {
+            usdinterop_asset_close(handle);
+            item.status = USDINTEROP_ASSET_READ_FAILED;
+            continue;
+          }
+          item.asset = handle;
+          item.status = USDINTEROP_ASSET_OK;
+          openedCount.fetch_add(1, std::memory_order_relaxed);
+        } catch (...) {
+          item.status = USDINTEROP_ASSET_OPEN_FAILED;
+        }
+      }
+    });
+    return openedCount.load();
+  } catch (...) {
+    for (size_t index = 0; index < asset_count; ++index) {
+      usdinterop_asset_close(results[index].asset);
+      results[index].asset = nullptr;
+      results[index].status = USDINTEROP_ASSET_OPEN_FAILED;
+    }
+    return 0;
+  }
+}
+
+USDInteropStringList usdinterop_resolve_batch(const char *anchor_asset_path,
+                                              const char *const *asset_paths,
+                                              size_t asset_count) {
+  USDInteropStringList result = {};
+  if (!asset_paths || asset_count == 0) {
+    return result;
+  }
+
+  try {
+    ArResolver &resolver = ArGetResolver();
+    const std::string anchorAssetPath = AnchorOrEmpty(anchor_asset_path);
+    const bool anchored = !anchorAssetPath.empty();
+
+    // Same context rules as `usdinterop_asset_open_batch`.
+    std::optional<ArResolverContextBinder> binder;
+    std::optional<ArResolverScopedCache> cache;
+    ArResolvedPath anchorResolvedPath;
+    if (anchored) {
+      binder.emplace(&resolver,
+                     resolver.CreateDefaultContextForAsset(anchorAssetPath));
+      cache.emplace();
+      anchorResolvedPath = resolver.Resolve(anchorAssetPath);
+    }
+
+    std::vector<std::string> resolved(asset_count);
+    std::vector<const std::string *> values(asset_count, nullptr);
+    for (size_t index = 0; index < asset_count; ++index) {
+      const char *assetPath = asset_paths[index];
+      if (!assetPath || assetPath[0] == '\0') {
+        continue;
+      }
+      try {
+        std::optional<ArResolverContextBinder> itemBinder;
+        if (!anchored) {
+          itemBinder.emplace(
+              &resolver, resolver.CreateDefaultContextForAsset(assetPath));
+        }
+        const ArResolvedPath resolvedPath = resolver.Resolve(
+            resolver.CreateIdentifier(assetPath, anchorResolvedPath));
+        if (resolvedPath.empty()) {
+          continue;
+        }
+        resolved[index] = resolvedPath.GetPathString();
+        values[index] = &resolved[index];
+      } catch (...) {
+        continue;
+      }
+    }
+    return USDInteropInternal::CopyToStringList(values);
+  } catch (...) {
+    return USDInteropStringList{};
+  }
+}
+
+void usdinterop_free_string_list(USDInteropStringList list) {
+  std::free(list.strings);
+}
@@ -1,40 +1,110 @@
 #include "USDInteropCxx.h"
+#include "USDInteropInternal.hpp"
 
 #include "pxr/base/gf/bbox3d.h"
+#include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/gf/range3d.h"
 #include "pxr/base/gf/vec3d.h"
 #include "pxr/base/gf/vec3f.h"
 #include "pxr/base/plug/registry.h"
 #include "pxr/base/plug/plugin.h"
+#include "pxr/base/tf/notice.h"
 #include "pxr/base/tf/token.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/base/work/threadLimits.h"
 #include "pxr/base/vt/array.h"
 #include "pxr/pxr.h"
-#include "pxr/usd/ar/asset.h"
 #include "pxr/usd/ar/packageUtils.h"
 #include "pxr/usd/ar/resolver.h"
-#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/sdf/changeBlock.h"
 #include "pxr/usd/sdf/copyUtils.h"
 #include "pxr/usd/sdf/primSpec.h"
 #include "pxr/usd/sdf/propertySpec.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usd/primRange.h"
 #include "pxr/usd/usd/property.h"
 #include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/stagePopulationMask.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/sdf/fileFormat.h"
 #include "pxr/usd/usdGeom/bboxCache.h"
+#include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/imageable.h"
+#include "pxr/usd/usdGeom/modelAPI.h"
 #include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformCache.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
 #include <cstdlib>
 #include <cstdint>
 #include <cstring>
-#include <filesystem>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+using USDInteropInternal::CopyToCString;
+using USDInteropInternal::ScopedStageHandle;
+using USDInteropInternal::StageReadScope;
+
+namespace USDInteropInternal {
+const char *CopyToCString(const std::string &value) {
+  char *buffer = static_cast<char *>(std::malloc(value.size() + 1));
+  if (!buffer) {
+    return nullptr;
+  }
+  std::memcpy(buffer, value.data(), value.size());
+  buffer[value.size()] = '\0';
+  return buffer;
+}
+
+USDInteropStringList
+CopyToStringList(const std::vector<const std::string *> &values) {
+  USDInteropStringList result = {};
+  size_t stringBytes = 0;
+  for (const std::string *value : values) {
+    if (value) {
+      stringBytes += value->size() + 1;
+    }
+  }
+
+  const size_t tableBytes = values.size() * sizeof(const char *);
+  auto *block = static_cast<char *>(std::malloc(tableBytes + stringBytes));
+  if (!block) {
+    return result;
+  }
+  auto **strings = reinterpret_cast<const char **>(block);
+  char *cursor = block + tableBytes;
+  for (size_t index = 0; index < values.size(); ++index) {
+    const std::string *value = values[index];
+    if (!value) {
+      strings[index] = nullptr;
+      continue;
+    }
+    std::memcpy(cursor, value->c_str(), value->size() + 1);
+    strings[index] = cursor;
+    cursor += value->size() + 1;
+  }
+
+  result.count = values.size();
+  result.strings = strings;
+  return result;
+}
+} // namespace USDInteropInternal
+
 namespace {
 bool StartsWithPathPrefix(const std::string &value, const std::string &prefix) {
   if (prefix.empty()) {
@@ -46,100 +116,664 @@ bool StartsWithPathPrefix(const std::string &value, const std::string &prefix) {
   return value.compare(0, prefix.size(), prefix) == 0;
 }
 
-const char *CopyToCString(const std::string &value) {
-  char *buffer = static_cast<char *>(std::malloc(value.size() + 1));
-  if (!buffer) {
-    return nullptr;
+// Chunk size for streamed JSON. Large enough to amortize sink calls, small
+// enough that peak memory no longer tracks the document size.
+constexpr size_t kJsonChunkSize = 64 * 1024;
+
+/// Buffers serialized output and hands it to a sink in fixed-size chunks.
+/// Once the sink reports failure, further output is dropped.
+class ChunkedJsonWriter {
+ public:
+  ChunkedJsonWriter(usdinterop_write_fn sink, void *context)
+      : _sink(sink), _context(context), _buffer(new char[kJsonChunkSize]) {}
+
+  void Append(const char *data, size_t size) {
+    while (size > 0 && !_failed) {
+      const size_t count = std::min(size, kJsonChunkSize - _used);
+      std::memcpy(_buffer.get() + _used, data, count);
+      _used += count;
+      data += count;
+      size -= count;
+      if (_used == kJsonChunkSize) {
+        Flush();
+      }
+    }
   }
-  std::memcpy(buffer, value.data(), value.size());
-  buffer[value.size()] = '\0';
-  return buffer;
-}
 
-const unsigned char *CopyToByteBuffer(const char *data, size_t size) {
-  if (!data && size != 0) {
-    return nullptr;
-  }
+  void Append(const char *literal) { Append(literal, std::strlen(literal)); }
 
-  auto *buffer = static_cast<unsigned char *>(std::malloc(size == 0 ? 1 : size));
-  if (!buffer) {
-    return nullptr;
+  /// Escapes `value` as JSON string content. Runs of bytes that need no
+  /// escaping are copied in bulk rather than one character at a time.
+  void AppendEscaped(const std::string &value) {
+    const char *data = value.data();
+    const size_t size = value.size();
+    size_t runStart = 0;
+    for (size_t index = 0; index < size; ++index) {
+      const unsigned char c = static_cast<unsigned char>(data[index]);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      Append(data + runStart, index - runStart);
+      AppendEscapedCharacter(c);
+      runStart = index + 1;
+    }
+    Append(data + runStart, size - runStart);
   }
 
-  if (size != 0) {
-    std::memcpy(buffer, data, size);
+  bool Flush() {
+    if (_failed) {
+      return false;
+    }
+    if (_used != 0 && _sink(_buffer.get(), _used, _context) != 0) {
+      _failed = true;
+    }
+    _used = 0;
+    return !_failed;
   }
 
-  return buffer;
-}
+  bool Failed() const { return _failed; }
 
-void EscapeJson(const std::string &value, std::string &out) {
-  for (char c : value) {
+ private:
+  void AppendEscapedCharacter(unsigned char c) {
     switch (c) {
     case '"':
-      out += "\\\"";
+      Append("\\\"", 2);
       break;
     case '\\':
-      out += "\\\\";
+      Append("\\\\", 2);
       break;
     case '\b':
-      out += "\\b";
+      Append("\\b", 2);
       break;
     case '\f':
-      out += "\\f";
+      Append("\\f", 2);
       break;
     case '\n':
-      out += "\\n";
+      Append("\\n", 2);
       break;
     case '\r':
-      out += "\\r";
+      Append("\\r", 2);
       break;
     case '\t':
-      out += "\\t";
+      Append("\\t", 2);
       break;
-    default:
-      if (static_cast<unsigned char>(c) < 0x20) {
-        char buffer[7];
-        std::snprintf(buffer, sizeof(buffer), "\\u%04x",
-                      static_cast<unsigned char>(c));
-        out += buffer;
-      } else {
-        out += c;
-      }
+    default: {
+      char buffer[7];
+      std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      Append(buffer, 6);
       break;
     }
+    }
   }
-}
 
-void AppendPrimJson(const UsdPrim &prim, std::string &out) {
-  std::string name = prim.GetName().GetString();
-  std::string path = prim.GetPath().GetString();
-  std::string typeName = prim.GetTypeName().GetString();
+  usdinterop_write_fn _sink;
+  void *_context;
+  std::unique_ptr<char[]> _buffer;
+  size_t _used = 0;
+  bool _failed = false;
+};
+
+void WritePrimJsonFields(const UsdPrim &prim, ChunkedJsonWriter &writer) {
+  const std::string &typeName = prim.GetTypeName().GetString();
 
-  out += "{\"name\":\"";
-  EscapeJson(name, out);
-  out += "\",\"path\":\"";
-  EscapeJson(path, out);
-  out += "\"";
+  writer.Append("{\"name\":\"");
+  writer.AppendEscaped(prim.GetName().GetString());
+  writer.Append("\",\"path\":\"");
+  writer.AppendEscaped(prim.GetPath().GetString());
+  writer.Append("\"");
 
   if (!typeName.empty()) {
-    out += ",\"type\":\"";
-    EscapeJson(typeName, out);
-    out += "\"";
+    writer.Append(",\"type\":\"");
+    writer.AppendEscaped(typeName);
+    writer.Append("\"");
+  }
+}
+
+void WritePrimJsonHeader(const UsdPrim &prim, ChunkedJsonWriter &writer) {
+  WritePrimJsonFields(prim, writer);
+  writer.Append(",\"children\":[");
+}
+
+void AppendJsonNumber(size_t value, ChunkedJsonWriter &writer) {
+  char buffer[24];
+  const int length = std::snprintf(buffer, sizeof(buffer), "%zu", value);
+  if (length > 0) {
+    writer.Append(buffer, static_cast<size_t>(length));
+  }
+}
+
+size_t CountChildren(const UsdPrimSiblingRange &children) {
+  return static_cast<size_t>(std::distance(children.begin(), children.end()));
+}
+
+/// Writes one page of `parent`'s children, expanded `depth` levels deep.
+/// Every node carries its `childCount`; nodes past the depth limit omit
+/// `children`. `limit` caps the page and every nested level (0 = no limit).
+bool WriteSceneGraphChildrenJson(const UsdPrim &parent,
+                                 int depth,
+                                 size_t offset,
+                                 size_t limit,
+                                 ChunkedJsonWriter &writer) {
+  struct Frame {
+    UsdPrimSiblingIterator next;
+    UsdPrimSiblingIterator end;
+    int level;
+    size_t emitted;
+  };
+
+  const int maxLevel = std::max(depth, 1);
+  const UsdPrimSiblingRange children = parent.GetChildren();
+
+  writer.Append("{\"path\":\"");
+  writer.AppendEscaped(parent.GetPath().GetString());
+  writer.Append("\",\"childCount\":");
+  AppendJsonNumber(CountChildren(children), writer);
+  writer.Append(",\"offset\":");
+  AppendJsonNumber(offset, writer);
+  writer.Append(",\"children\":[");
+
+  UsdPrimSiblingIterator first = children.begin();
+  for (size_t skipped = 0; skipped < offset && first != children.end();
+       ++skipped) {
+    ++first;
+  }
+
+  std::vector<Frame> stack;
+  stack.push_back(Frame{first, children.end(), 1, 0});
+  while (!stack.empty() && !writer.Failed()) {
+    Frame &frame = stack.back();
+    if (frame.next == frame.end || (limit != 0 && frame.emitted == limit)) {
+      stack.pop_back();
+      writer.Append("]}");
+      continue;
+    }
+
+    const UsdPrim prim = *frame.next;
+    ++frame.next;
+    if (frame.emitted != 0) {
+      writer.Append(",");
+    }
+    ++frame.emitted;
+    const int level = frame.level;
+
+    const UsdPrimSiblingRange grandchildren = prim.GetChildren();
+    WritePrimJsonFields(prim, writer);
+    writer.Append(",\"childCount\":");
+    AppendJsonNumber(CountChildren(grandchildren), writer);
+    if (level < maxLevel) {
+      writer.Append(",\"children\":[");
+      stack.push_back(
+          Frame{grandchildren.begin(), grandchildren.end(), level + 1, 0});
+    } else {
+      writer.Append("}");
+    }
+  }
+
+  return writer.Flush();
+}
+
+/// Streams the prim hierarchy as a JSON array of nested prim objects. Uses an
+/// explicit stack so deep hierarchies cannot exhaust the native call stack.
+bool WriteSceneGraphJson(const UsdStageRefPtr &stage, ChunkedJsonWriter &writer) {
+  UsdPrim pseudoRoot = stage->GetPseudoRoot();
+  if (!pseudoRoot.IsValid()) {
+    return false;
+  }
+
+  struct Frame {
+    UsdPrimSiblingIterator next;
+    UsdPrimSiblingIterator end;
+    bool first;
+  };
+
+  std::vector<Frame> stack;
+  const UsdPrimSiblingRange roots = pseudoRoot.GetChildren();
+  stack.push_back(Frame{roots.begin(), roots.end(), true});
+
+  writer.Append("[");
+  while (!stack.empty() && !writer.Failed()) {
+    Frame &frame = stack.back();
+    if (frame.next == frame.end) {
+      stack.pop_back();
+      writer.Append(stack.empty() ? "]" : "]}");
+      continue;
+    }
+
+    const UsdPrim prim = *frame.next;
+    ++frame.next;
+    if (!frame.first) {
+      writer.Append(",");
+    }
+    frame.first = false;
+
+    WritePrimJsonHeader(prim, writer);
+    const UsdPrimSiblingRange children = prim.GetChildren();
+    stack.push_back(Frame{children.begin(), children.end(), true});
+  }
+
+  return writer.Flush();
+}
+
+/// Growable malloc buffer used to hand a complete document back as a C string
+/// without the extra copy `CopyToCString` would make.
+struct MallocStringSink {
+  char *data = nullptr;
+  size_t size = 0;
+  size_t capacity = 0;
+};
+
+int AppendToMallocString(const char *data, size_t size, void *context) {
+  auto *sink = static_cast<MallocStringSink *>(context);
+  if (sink->size + size + 1 > sink->capacity) {
+    size_t capacity = std::max<size_t>(sink->capacity * 2, kJsonChunkSize);
+    while (sink->size + size + 1 > capacity) {
+      capacity *= 2;
+    }
+    auto *grown = static_cast<char *>(std::realloc(sink->data, capacity));
+    if (!grown) {
+      return 1;
+    }
+    sink->data = grown;
+    sink->capacity = capacity;
+  }
+  std::memcpy(sink->data + sink->size, data, size);
+  sink->size += size;
+  return 0;
+}
+
+int WriteToFileDescriptor(const char *data, size_t size, void *context) {
+  const int fd = *static_cast<const int *>(context);
+  while (size > 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return 1;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return 0;
+}
+
+TfTokenVector BoundsPurposes() {
+  return {UsdGeomTokens->default_, UsdGeomTokens->render};
+}
+
+USDInteropBounds MakeBounds(const GfRange3d &range) {
+  USDInteropBounds result = {};
+  result.hasGeometry = 0;
+
+  if (!range.IsEmpty()) {
+    result.hasGeometry = 1;
+    GfVec3d min = range.GetMin();
+    GfVec3d max = range.GetMax();
+    result.minX = static_cast<float>(min[0]);
+    result.minY = static_cast<float>(min[1]);
+    result.minZ = static_cast<float>(min[2]);
+    result.maxX = static_cast<float>(max[0]);
+    result.maxY = static_cast<float>(max[1]);
+    result.maxZ = static_cast<float>(max[2]);
+    result.centerX = static_cast<float>((min[0] + max[0]) / 2.0);
+    result.centerY = static_cast<float>((min[1] + max[1]) / 2.0);
+    result.centerZ = static_cast<float>((min[2] + max[2]) / 2.0);
+    double extentX = max[0] - min[0];
+    double extentY = max[1] - min[1];
+    double extentZ = max[2] - min[2];
+    result.maxExtent =
+        static_cast<float>(std::max(extentX, std::max(extentY, extentZ)));
   }
 
-  out += ",\"children\":[";
+  return result;
+}
 
-  bool first = true;
-  for (const auto &child : prim.GetChildren()) {
-    if (!first) {
-      out += ",";
+/// Writes min xyz then max xyz. Empty ranges are written as an inverted box
+/// (min = FLT_MAX, max = -FLT_MAX) so callers can test `min > max`.
+void WriteRange(const GfRange3d &range, float *out) {
+  if (range.IsEmpty()) {
+    const float largest = std::numeric_limits<float>::max();
+    out[0] = out[1] = out[2] = largest;
+    out[3] = out[4] = out[5] = -largest;
+    return;
+  }
+  const GfVec3d &min = range.GetMin();
+  const GfVec3d &max = range.GetMax();
+  for (int axis = 0; axis < 3; ++axis) {
+    out[axis] = static_cast<float>(min[axis]);
+    out[axis + 3] = static_cast<float>(max[axis]);
+  }
+}
+
+/// Range covered by the default and render purposes of an `extentsHint`,
+/// which stores one (min, max) pair per purpose in the ordered purpose list.
+/// Returns false when the hint is not authored in a usable shape.
+bool RangeFromExtentsHint(const VtVec3fArray &hint, GfRange3d *range) {
+  if (hint.size() < 2 || hint.size() % 2 != 0) {
+    return false;
+  }
+
+  const TfTokenVector &purposes = UsdGeomImageable::GetOrderedPurposeTokens();
+  GfRange3d result;
+  for (size_t index = 0; index < purposes.size() && 2 * index + 1 < hint.size();
+       ++index) {
+    if (purposes[index] != UsdGeomTokens->default_ &&
+        purposes[index] != UsdGeomTokens->render) {
+      continue;
+    }
+    const GfRange3d purposeRange(GfVec3d(hint[2 * index]),
+                                 GfVec3d(hint[2 * index + 1]));
+    if (!purposeRange.IsEmpty()) {
+      result.UnionWith(purposeRange);
     }
-    AppendPrimJson(child, out);
-    first = false;
   }
+  *range = result;
+  return true;
+}
 
-  out += "]}";
+/// Invisible subtrees and proxy or guide purposes are left out of framing
+/// bounds, as `UsdGeomBBoxCache` leaves them out.
+bool IsExcludedFromBounds(const UsdPrim &prim, UsdTimeCode timeCode) {
+  const UsdGeomImageable imageable(prim);
+  if (!imageable) {
+    return false;
+  }
+  TfToken visibility;
+  if (imageable.GetVisibilityAttr().Get(&visibility, timeCode) &&
+      visibility == UsdGeomTokens->invisible) {
+    return true;
+  }
+  TfToken purpose;
+  if (!imageable.GetPurposeAttr().Get(&purpose)) {
+    return false;
+  }
+  return purpose == UsdGeomTokens->proxy || purpose == UsdGeomTokens->guide;
+}
+
+/// One subtree's share of a fast bounds result.
+struct FastBoundContribution {
+  SdfPath primPath;
+  int strategy;
+  GfRange3d worldRange;
+};
+
+void AddFastBound(const UsdPrim &prim,
+                  const GfRange3d &localRange,
+                  const GfMatrix4d &localToWorld,
+                  int strategy,
+                  int *strategyCount,
+                  GfRange3d &worldRange,
+                  USDInteropFastBounds &result,
+                  std::vector<FastBoundContribution> *contributions) {
+  GfRange3d primRange;
+  if (!localRange.IsEmpty()) {
+    primRange = GfBBox3d(localRange, localToWorld).ComputeAlignedRange();
+    worldRange.UnionWith(primRange);
+  }
+  result.strategies |= strategy;
+  ++*strategyCount;
+  if (contributions) {
+    contributions->push_back({prim.GetPath(), strategy, primRange});
+  }
+}
+
+/// Bounds from authored data first: `extentsHint` on models, then authored
+/// `extent` on boundables, then extents computed from geometry. Payloads are
+/// only loaded, on a separate uncached masked stage, for unloaded subtrees
+/// that carry neither, so the caller's stage is never mutated. When `contributions` is
+/// given, it receives the strategy and world range of each bounded subtree.
+USDInteropFastBounds
+ComputeFastBounds(const UsdStageRefPtr &stage,
+                  std::vector<FastBoundContribution> *contributions) {
+  USDInteropFastBounds result = {};
+
+  UsdPrim root = stage->GetDefaultPrim();
+  if (!root.IsValid()) {
+    root = stage->GetPseudoRoot();
+  }
+
+  const UsdTimeCode timeCode = UsdTimeCode::Default();
+  UsdGeomXformCache xformCache(timeCode);
+  GfRange3d worldRange;
+  SdfPathVector unloadedPaths;
+
+  // Unloaded payload prims fail the default IsLoaded predicate, so build
+  // one that still visits them.
+  const UsdPrimRange range(
+      root, UsdTraverseInstanceProxies(UsdPrimIsActive && UsdPrimIsDefined &&
+                                       !UsdPrimIsAbstract));
+  for (auto it = range.begin(); it != range.end(); ++it) {
+    const UsdPrim &prim = *it;
+    if (prim.IsPseudoRoot()) {
+      continue;
+    }
+    if (IsExcludedFromBounds(prim, timeCode)) {
+      it.PruneChildren();
+      continue;
+    }
+
+    if (prim.IsModel()) {
+      VtVec3fArray hint;
+      GfRange3d hintRange;
+      if (UsdGeomModelAPI(prim).GetExtentsHint(&hint, timeCode) &&
+          RangeFromExtentsHint(hint, &hintRange)) {
+        AddFastBound(prim, hintRange,
+                     xformCache.GetLocalToWorldTransform(prim),
+                     USDINTEROP_BOUNDS_EXTENTS_HINT, &result.extentsHintCount,
+                     worldRange, result, contributions);
+        it.PruneChildren();
+        continue;
+      }
+    }
+
+    // An authored extent bounds the subtree whether or not its payload is
+    // loaded.
+    const UsdGeomBoundable boundable(prim);
+    VtVec3fArray extent;
+    if (boundable && boundable.GetExtentAttr().Get(&extent, timeCode) &&
+        extent.size() == 2) {
+      AddFastBound(prim, GfRange3d(GfVec3d(extent[0]), GfVec3d(extent[1])),
+                   xformCache.GetLocalToWorldTransform(prim),
+                   USDINTEROP_BOUNDS_AUTHORED_EXTENT,
+                   &result.authoredExtentCount, worldRange, result,
+                   contributions);
+      it.PruneChildren();
+      continue;
+    }
+
+    if (!prim.IsLoaded()) {
+      unloadedPaths.push_back(prim.GetPath());
+      it.PruneChildren();
+      continue;
+    }
+
+    if (boundable &&
+        UsdGeomBoundable::ComputeExtentFromPlugins(boundable, timeCode,
+                                                   &extent) &&
+        extent.size() == 2) {
+      AddFastBound(prim, GfRange3d(GfVec3d(extent[0]), GfVec3d(extent[1])),
+                   xformCache.GetLocalToWorldTransform(prim),
+                   USDINTEROP_BOUNDS_COMPUTED_EXTENT,
+                   &result.computedExtentCount, worldRange, result,
+                   contributions);
+      it.PruneChildren();
+    }
+  }
+
+  if (!unloadedPaths.empty()) {
+    // One masked stage loads every payload that lacked a hint or extent. It
+    // composes the caller's session layer too, and stays out of the stage
+    // cache so it cannot evict the caller's stages.
+    UsdStagePopulationMask mask;
+    for (const SdfPath &path : unloadedPaths) {
+      mask.Add(path);
+    }
+    const UsdStageRefPtr loadedStage = UsdStage::OpenMasked(
+        stage->GetRootLayer(), stage->GetSessionLayer(),
+        stage->GetPathResolverContext(), mask, UsdStage::LoadAll);
+    if (loadedStage) {
+      UsdGeomBBoxCache bboxCache(timeCode, BoundsPurposes(), true);
+      for (const SdfPath &path : unloadedPaths) {
+        const UsdPrim prim = loadedStage->GetPrimAtPath(path);
+        if (!prim.IsValid()) {
+          continue;
+        }
+        const GfRange3d loadedRange =
+            bboxCache.ComputeWorldBound(prim).ComputeAlignedRange();
+        if (!loadedRange.IsEmpty()) {
+          worldRange.UnionWith(loadedRange);
+        }
+        result.strategies |= USDINTEROP_BOUNDS_LOADED_PAYLOAD;
+        ++result.loadedPayloadCount;
+        if (contributions) {
+          contributions->push_back(
+              {prim.GetPath(), USDINTEROP_BOUNDS_LOADED_PAYLOAD, loadedRange});
+        }
+      }
+    }
+  }
+
+  result.bounds = MakeBounds(worldRange);
+  return result;
+}
+
+/// Struct-of-arrays form of the prim hierarchy behind the binary scene graph.
+/// Names and type tokens are interned so each distinct string is stored once.
+struct SceneGraphArrays {
+  std::vector<int32_t> parentIndices;
+  std::vector<int32_t> firstChildIndices;
+  std::vector<int32_t> nextSiblingIndices;
+  std::vector<uint32_t> nameIndices;
+  std::vector<int32_t> typeIndices;
+  std::vector<TfToken> strings;
+  std::unordered_map<TfToken, uint32_t, TfToken::HashFunctor> stringIndices;
+
+  uint32_t Intern(const TfToken &token) {
+    const auto inserted = stringIndices.emplace(
+        token, static_cast<uint32_t>(strings.size()));
+    if (inserted.second) {
+      strings.push_back(token);
+    }
+    return inserted.first->second;
+  }
+};
+
+/// Collects the hierarchy in pre-order using the same `GetChildren`
+/// traversal as the JSON writer.
+bool CollectSceneGraphArrays(const UsdStageRefPtr &stage,
+                             SceneGraphArrays &arrays) {
+  UsdPrim pseudoRoot = stage->GetPseudoRoot();
+  if (!pseudoRoot.IsValid()) {
+    return false;
+  }
+
+  struct Frame {
+    UsdPrimSiblingIterator next;
+    UsdPrimSiblingIterator end;
+    int32_t parent;
+    int32_t previous;
+  };
+
+  std::vector<Frame> stack;
+  const UsdPrimSiblingRange roots = pseudoRoot.GetChildren();
+  stack.push_back(Frame{roots.begin(), roots.end(), -1, -1});
+
+  while (!stack.empty()) {
+    Frame &frame = stack.back();
+    if (frame.next == frame.end) {
+      stack.pop_back();
+      continue;
+    }
+
+    const UsdPrim prim = *frame.next;
+    ++frame.next;
+
+    if (arrays.parentIndices.size() >=
+        static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      return false;
+    }
+    const int32_t index = static_cast<int32_t>(arrays.parentIndices.size());
+    const TfToken &typeName = prim.GetTypeName();
+
+    arrays.parentIndices.push_back(frame.parent);
+    arrays.firstChildIndices.push_back(-1);
+    arrays.nextSiblingIndices.push_back(-1);
+    arrays.nameIndices.push_back(arrays.Intern(prim.GetName()));
+    arrays.typeIndices.push_back(
+        typeName.IsEmpty() ? -1 : static_cast<int32_t>(arrays.Intern(typeName)));
+
+    if (frame.previous >= 0) {
+      arrays.nextSiblingIndices[frame.previous] = index;
+    } else if (frame.parent >= 0) {
+      arrays.firstChildIndices[frame.parent] = index;
+    }
+    frame.previous = index;
+
+    const UsdPrimSiblingRange children = prim.GetChildren();
+    stack.push_back(Frame{children.begin(), children.end(), index, -1});
+  }
+
+  return true;
+}
+
+template <typename T>
+void CopyArray(unsigned char *block, uint64_t offset, const std::vector<T> &values) {
+  if (!values.empty()) {
+    std::memcpy(block + offset, values.data(), values.size() * sizeof(T));
+  }
+}
+
+const void *MakeSceneGraphBinary(const SceneGraphArrays &arrays, size_t *size) {
+  const uint64_t primCount = arrays.parentIndices.size();
+  const uint64_t stringCount = arrays.strings.size();
+
+  uint64_t stringDataSize = 0;
+  for (const TfToken &token : arrays.strings) {
+    stringDataSize += token.size() + 1;
+  }
+  if (stringDataSize > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+
+  USDInteropSceneGraphBinaryHeader header = {};
+  header.magic = USDINTEROP_SCENE_GRAPH_BINARY_MAGIC;
+  header.version = USDINTEROP_SCENE_GRAPH_BINARY_VERSION;
+  header.primCount = static_cast<uint32_t>(primCount);
+  header.stringCount = static_cast<uint32_t>(stringCount);
+  header.parentIndexOffset = sizeof(header);
+  header.firstChildOffset = header.parentIndexOffset + primCount * sizeof(int32_t);
+  header.nextSiblingOffset = header.firstChildOffset + primCount * sizeof(int32_t);
+  header.nameIndexOffset = header.nextSiblingOffset + primCount * sizeof(int32_t);
+  header.typeIndexOffset = header.nameIndexOffset + primCount * sizeof(uint32_t);
+  header.stringOffsetsOffset = header.typeIndexOffset + primCount * sizeof(int32_t);
+  header.stringDataOffset = header.stringOffsetsOffset + stringCount * sizeof(uint32_t);
+  header.totalSize = header.stringDataOffset + stringDataSize;
+
+  auto *block = static_cast<unsigned char *>(std::malloc(header.totalSize));
+  if (!block) {
+    return nullptr;
+  }
+
+  std::memcpy(block, &header, sizeof(header));
+  CopyArray(block, header.parentIndexOffset, arrays.parentIndices);
+  CopyArray(block, header.firstChildOffset, arrays.firstChildIndices);
+  CopyArray(block, header.nextSiblingOffset, arrays.nextSiblingIndices);
+  CopyArray(block, header.nameIndexOffset, arrays.nameIndices);
+  CopyArray(block, header.typeIndexOffset, arrays.typeIndices);
+
+  auto *stringOffsets =
+      reinterpret_cast<uint32_t *>(block + header.stringOffsetsOffset);
+  char *stringData = reinterpret_cast<char *>(block + header.stringDataOffset);
+  uint32_t stringOffset = 0;
+  for (size_t index = 0; index < arrays.strings.size(); ++index) {
+    const std::string &value = arrays.strings[index].GetString();
+    stringOffsets[index] = stringOffset;
+    std::memcpy(stringData + stringOffset, value.c_str(), value.size() + 1);
+    stringOffset += static_cast<uint32_t>(value.size() + 1);
+  }
+
+  *size = static_cast<size_t>(header.totalSize);
+  return block;
 }
 
 USDInteropSourceSite MakeSourceSite(
@@ -202,6 +836,78 @@ USDInteropSourceSiteList MakeSourceSiteList(const HandleVector &specStack) {
   result.sites = sites;
   return result;
 }
+
+/// Applies one edit. `valueType` is the attribute's value type, looked up
+/// before the change block; a value of any other type is rejected up front
+/// rather than left for `Set` to fail on.
+uint8_t ApplyAttributeEdit(const UsdAttribute &attr, const TfType &valueType,
+                           const USDInterop::AttributeEditCxx &edit) {
+  VtValue value;
+  switch (edit.type) {
+    case USDInterop::AttributeEditBool:
+      value = VtValue(edit.intValue != 0);
+      break;
+    case USDInterop::AttributeEditInt:
+      value = VtValue(static_cast<int32_t>(edit.intValue));
+      break;
+    case USDInterop::AttributeEditFloat:
+      value = VtValue(edit.floatValues[0]);
+      break;
+    case USDInterop::AttributeEditColor3f:
+      value = VtValue(GfVec3f(edit.floatValues[0], edit.floatValues[1],
+                              edit.floatValues[2]));
+      break;
+    case USDInterop::AttributeEditString:
+      value = VtValue(edit.text);
+      break;
+    case USDInterop::AttributeEditToken:
+      value = VtValue(TfToken(edit.text));
+      break;
+    case USDInterop::AttributeEditAssetPath:
+      value = VtValue(SdfAssetPath(edit.text));
+      break;
+    case USDInterop::AttributeEditBlock:
+      attr.Block();
+      return USDInterop::AttributeEditApplied;
+    default:
+      return USDInterop::AttributeEditInvalidType;
+  }
+  if (value.GetType() != valueType) {
+    return USDInterop::AttributeEditInvalidType;
+  }
+  return attr.Set(value, edit.timeCode) ? USDInterop::AttributeEditApplied
+                                        : USDInterop::AttributeEditFailed;
+}
+
+/// Listener behind `BeginObjectsChangedCount`.
+class ObjectsChangedCounter : public TfWeakBase {
+ public:
+  explicit ObjectsChangedCounter(const UsdStage &stage) {
+    _key = TfNotice::Register(
+        TfCreateWeakPtr(this), &ObjectsChangedCounter::OnObjectsChanged,
+        UsdStageWeakPtr(const_cast<UsdStage *>(&stage)));
+  }
+
+  /// Stops listening, waiting out a notice being delivered on another
+  /// thread, and returns the count.
+  int Finish() {
+    TfNotice::RevokeAndWait(_key);
+    return _count.load();
+  }
+
+ private:
+  void OnObjectsChanged(const UsdNotice::ObjectsChanged &) {
+    _count.fetch_add(1);
+  }
+
+  TfNotice::Key _key;
+  std::atomic<int> _count{0};
+};
+
+std::mutex g_objectsChangedCountersMutex;
+std::unordered_map<int, std::unique_ptr<ObjectsChangedCounter>>
+    g_objectsChangedCounters;
+int g_nextObjectsChangedCounterId = 0;
 } // namespace
 
 namespace USDInterop {
@@ -313,6 +1019,66 @@ bool BlockAttribute(USD::UsdAttribute attr) {
   }
 }
 
+std::vector<uint8_t> ApplyAttributeEdits(
+    const USD::UsdStage &stage,
+    const AttributeEditListCxx &edits) {
+  std::vector<uint8_t> statuses(edits.size(), AttributeEditFailed);
+  try {
+    // Look every attribute up first; composed queries are not safe while
+    // the change block holds notices back.
+    std::vector<USD::UsdAttribute> attributes(edits.size());
+    std::vector<TfType> valueTypes(edits.size());
+    for (size_t i = 0; i < edits.size(); ++i) {
+      attributes[i] = stage.GetAttributeAtPath(edits[i].attributePath);
+      if (!attributes[i]) {
+        statuses[i] = AttributeEditMissingAttribute;
+      } else {
+        valueTypes[i] = attributes[i].GetTypeName().GetType();
+      }
+    }
+
+    SdfChangeBlock changeBlock;
+    for (size_t i = 0; i < edits.size(); ++i) {
+      if (!attributes[i]) {
+        continue;
+      }
+      try {
+        statuses[i] = ApplyAttributeEdit(attributes[i], valueTypes[i], edits[i]);
+      } catch (...) {
+        statuses[i] = AttributeEditFailed;
+      }
+    }
+  } catch (...) {
+  }
+  return statuses;
+}
+
+int BeginObjectsChangedCount(const USD::UsdStage &stage) {
+  try {
+    auto counter = std::make_unique<ObjectsChangedCounter>(stage);
+    std::lock_guard<std::mutex> lock(g_objectsChangedCountersMutex);
+    const int id = g_nextObjectsChangedCounterId++;
+    g_objectsChangedCounters.emplace(id, std::move(counter));
+    return id;
+  } catch (...) {
+    return -1;
+  }
+}
+
+int EndObjectsChangedCount(int id) {
+  std::unique_ptr<ObjectsChangedCounter> counter;
+  {
+    std::lock_guard<std::mutex> lock(g_objectsChangedCountersMutex);
+    const auto found = g_objectsChangedCounters.find(id);
+    if (found == g_objectsChangedCounters.end()) {
+      return -1;
+    }
+    counter = std::move(found->second);
+    g_objectsChangedCounters.erase(found);
+  }
+  return counter->Finish();
+}
+
 bool DisconnectShadeInput(USD::UsdShadeInput input) {
   try {
     return input.DisconnectSource(USD::UsdAttribute());
@@ -375,7 +1141,13 @@ const char *usdinterop_export_usda(const char *path) {
     return nullptr;
   }
 
-  UsdStageRefPtr stage = UsdStage::Open(std::string(path));
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_ALL));
+  return usdinterop_export_usda_for_stage(stage.get());
+}
+
+const char *usdinterop_export_usda_for_stage(const usdinterop_stage_t *handle) {
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
   if (!stage) {
     return nullptr;
   }
@@ -393,28 +1165,134 @@ const char *usdinterop_scene_graph_json(const char *path) {
     return nullptr;
   }
 
-  UsdStageRefPtr stage = UsdStage::Open(std::string(path));
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_ALL));
+  return usdinterop_scene_graph_json_for_stage(stage.get());
+}
+
+const char *usdinterop_scene_graph_json_for_stage(
+    const usdinterop_stage_t *handle) {
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
   if (!stage) {
     return nullptr;
   }
 
-  UsdPrim pseudoRoot = stage->GetPseudoRoot();
-  if (!pseudoRoot.IsValid()) {
+  MallocStringSink sink;
+  ChunkedJsonWriter writer(AppendToMallocString, &sink);
+  if (!WriteSceneGraphJson(stage, writer)) {
+    std::free(sink.data);
     return nullptr;
   }
 
-  std::string output = "[";
-  bool first = true;
-  for (const auto &child : pseudoRoot.GetChildren()) {
-    if (!first) {
-      output += ",";
-    }
-    AppendPrimJson(child, output);
-    first = false;
+  // The sink always reserves room for the terminator.
+  sink.data[sink.size] = '\0';
+  return sink.data;
+}
+
+int usdinterop_scene_graph_json_write(const usdinterop_stage_t *handle,
+                                      usdinterop_write_fn sink,
+                                      void *context) {
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage || !sink) {
+    return 0;
   }
-  output += "]";
 
-  return CopyToCString(output);
+  ChunkedJsonWriter writer(sink, context);
+  return WriteSceneGraphJson(stage, writer) ? 1 : 0;
+}
+
+int usdinterop_scene_graph_json_write_fd(const usdinterop_stage_t *handle,
+                                         int fd) {
+  if (fd < 0) {
+    return 0;
+  }
+  return usdinterop_scene_graph_json_write(handle, WriteToFileDescriptor, &fd);
+}
+
+const char *usdinterop_scene_graph_children_json(const char *path,
+                                                 const char *prim_path,
+                                                 int depth,
+                                                 size_t offset,
+                                                 size_t limit) {
+  if (!path || path[0] == '\0' || !prim_path || prim_path[0] == '\0') {
+    return nullptr;
+  }
+
+  // Every expansion shares the file's cached stage. A stage masked to each
+  // expanded node would take its own cache entry and push the caller's real
+  // stages out of the LRU while a tree is browsed.
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_ALL));
+  return usdinterop_scene_graph_children_json_for_stage(
+      stage.get(), prim_path, depth, offset, limit);
+}
+
+const char *usdinterop_scene_graph_children_json_for_stage(
+    const usdinterop_stage_t *handle,
+    const char *prim_path,
+    int depth,
+    size_t offset,
+    size_t limit) {
+  if (!prim_path || prim_path[0] == '\0') {
+    return nullptr;
+  }
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage) {
+    return nullptr;
+  }
+
+  const SdfPath path(prim_path);
+  if (!path.IsAbsolutePath() ||
+      !(path.IsAbsoluteRootPath() || path.IsPrimPath())) {
+    return nullptr;
+  }
+
+  const UsdPrim parent = stage->GetPrimAtPath(path);
+  if (!parent.IsValid()) {
+    return nullptr;
+  }
+
+  MallocStringSink sink;
+  ChunkedJsonWriter writer(AppendToMallocString, &sink);
+  if (!WriteSceneGraphChildrenJson(parent, depth, offset, limit, writer)) {
+    std::free(sink.data);
+    return nullptr;
+  }
+
+  sink.data[sink.size] = '\0';
+  return sink.data;
+}
+
+const void *usdinterop_scene_graph_binary(const char *path, size_t *size) {
+  if (!path || path[0] == '\0' || !size) {
+    return nullptr;
+  }
+
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_ALL));
+  return usdinterop_scene_graph_binary_for_stage(stage.get(), size);
+}
+
+const void *usdinterop_scene_graph_binary_for_stage(
+    const usdinterop_stage_t *handle,
+    size_t *size) {
+  if (!size) {
+    return nullptr;
+  }
+  *size = 0;
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage) {
+    return nullptr;
+  }
+
+  SceneGraphArrays arrays;
+  if (!CollectSceneGraphArrays(stage, arrays)) {
+    return nullptr;
+  }
+  return MakeSceneGraphBinary(arrays, size);
 }
 
 void usdinterop_free_string(const char *value) {
@@ -432,34 +1310,28 @@ USDInteropBounds usdinterop_scene_bounds(const char *path) {
     return result;
   }
 
-  const std::string stagePath(path);
-  const bool isSessionLayer =
-      std::filesystem::path(stagePath).filename() == "session.usda";
-
-  if (isSessionLayer) {
-    try {
-      std::filesystem::last_write_time(
-          stagePath, std::filesystem::file_time_type::clock::now());
-    } catch (...) {
-      // Best-effort cache-bust for session layers.
-    }
-  }
-
-  UsdStageRefPtr stage = UsdStage::Open(stagePath);
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_ALL));
   if (!stage) {
     return result;
   }
 
-  if (isSessionLayer) {
-    // Avoid reloading immediately after opening session.usda.
-    // Open() already reflects current on-disk state, and a forced Reload()
-    // has been observed to crash intermittently during startup.
+  return usdinterop_scene_bounds_for_stage(stage.get());
+}
+
+USDInteropBounds usdinterop_scene_bounds_for_stage(
+    const usdinterop_stage_t *handle) {
+  USDInteropBounds result = {};
+  result.hasGeometry = 0;
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage) {
+    return result;
   }
 
   // Use UsdGeomBBoxCache for proper bounds calculation
   // This works correctly with payloads, references, and variants
-  TfTokenVector purposes = {UsdGeomTokens->default_, UsdGeomTokens->render};
-  UsdGeomBBoxCache bboxCache(UsdTimeCode::Default(), purposes, true);
+  UsdGeomBBoxCache bboxCache(UsdTimeCode::Default(), BoundsPurposes(), true);
 
   UsdPrim root = stage->GetDefaultPrim();
   if (!root.IsValid()) {
@@ -467,29 +1339,162 @@ USDInteropBounds usdinterop_scene_bounds(const char *path) {
   }
 
   GfBBox3d worldBounds = bboxCache.ComputeWorldBound(root);
-  GfRange3d range = worldBounds.ComputeAlignedBox();
+  return MakeBounds(worldBounds.ComputeAlignedBox());
+}
 
-  if (!range.IsEmpty()) {
-    result.hasGeometry = 1;
-    GfVec3d min = range.GetMin();
-    GfVec3d max = range.GetMax();
-    result.minX = static_cast<float>(min[0]);
-    result.minY = static_cast<float>(min[1]);
-    result.minZ = static_cast<float>(min[2]);
-    result.maxX = static_cast<float>(max[0]);
-    result.maxY = static_cast<float>(max[1]);
-    result.maxZ = static_cast<float>(max[2]);
-    result.centerX = static_cast<float>((min[0] + max[0]) / 2.0);
-    result.centerY = static_cast<float>((min[1] + max[1]) / 2.0);
-    result.centerZ = static_cast<float>((min[2] + max[2]) / 2.0);
-    double extentX = max[0] - min[0];
-    double extentY = max[1] - min[1];
-    double extentZ = max[2] - min[2];
-    result.maxExtent =
-        static_cast<float>(std::max(extentX, std::max(extentY, extentZ)));
+USDInteropFastBounds usdinterop_scene_bounds_fast(const char *path) {
+  USDInteropFastBounds result = {};
+  if (!path || path[0] == '\0') {
+    return result;
   }
 
-  return result;
+  ScopedStageHandle stage(usdinterop_stage_open(path, USDINTEROP_LOAD_NONE));
+  return usdinterop_scene_bounds_fast_for_stage(stage.get());
+}
+
+USDInteropFastBounds usdinterop_scene_bounds_fast_for_stage(
+    const usdinterop_stage_t *handle) {
+  USDInteropFastBounds result = {};
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage) {
+    return result;
+  }
+
+  try {
+    return ComputeFastBounds(stage, nullptr);
+  } catch (...) {
+    return result;
+  }
+}
+
+USDInteropFastBoundsDetail usdinterop_scene_bounds_fast_detail_for_stage(
+    const usdinterop_stage_t *handle) {
+  USDInteropFastBoundsDetail detail = {};
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage) {
+    return detail;
+  }
+
+  try {
+    std::vector<FastBoundContribution> contributions;
+    const USDInteropFastBounds summary =
+        ComputeFastBounds(stage, &contributions);
+
+    size_t textSize = 0;
+    for (const FastBoundContribution &contribution : contributions) {
+      textSize += contribution.primPath.GetString().size() + 1;
+    }
+    const size_t tableBytes =
+        contributions.size() * sizeof(USDInteropBoundContribution);
+    char *block = static_cast<char *>(std::malloc(tableBytes + textSize));
+    if (!block) {
+      return detail;
+    }
+
+    auto *table = reinterpret_cast<USDInteropBoundContribution *>(block);
+    char *text = block + tableBytes;
+    for (size_t i = 0; i < contributions.size(); ++i) {
+      const FastBoundContribution &contribution = contributions[i];
+      const std::string &path = contribution.primPath.GetString();
+      std::memcpy(text, path.c_str(), path.size() + 1);
+      table[i].primPath = text;
+      table[i].strategy = contribution.strategy;
+      WriteRange(contribution.worldRange, table[i].range);
+      text += path.size() + 1;
+    }
+
+    detail.summary = summary;
+    detail.contributionCount = contributions.size();
+    detail.contributions = table;
+    return detail;
+  } catch (...) {
+    return USDInteropFastBoundsDetail{};
+  }
+}
+
+void usdinterop_free_fast_bounds_detail(USDInteropFastBoundsDetail detail) {
+  // The prim path strings share the table's allocation.
+  std::free(detail.contributions);
+}
+
+int usdinterop_compute_bounds_batch(const usdinterop_stage_t *handle,
+                                    const char *const *prim_paths,
+                                    size_t prim_count,
+                                    const double *time_codes,
+                                    size_t time_count,
+                                    float *out_bounds) {
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
+  if (!stage || !prim_paths || !out_bounds) {
+    return -1;
+  }
+  if (!time_codes) {
+    time_count = 1;
+  }
+  if (prim_count == 0 || time_count == 0) {
+    return 0;
+  }
+  if (prim_count > std::numeric_limits<size_t>::max() / 6 / time_count) {
+    return -1;
+  }
+
+  // Resolve prims once; every time sample shares them.
+  std::vector<UsdPrim> prims(prim_count);
+  for (size_t index = 0; index < prim_count; ++index) {
+    const char *primPath = prim_paths[index];
+    if (!primPath || primPath[0] == '\0') {
+      continue;
+    }
+    const SdfPath path(primPath);
+    if (path.IsAbsolutePath() && path.IsPrimPath()) {
+      prims[index] = stage->GetPrimAtPath(path);
+    }
+  }
+
+  std::atomic<int> nonEmptyCount(0);
+  const TfTokenVector purposes = BoundsPurposes();
+
+  // A UsdGeomBBoxCache must not be queried concurrently, so each task owns
+  // one for a single time code. Each time's prims are split into just
+  // enough contiguous ranges to occupy every worker: a batch with one time
+  // code spreads across cores, one with many time codes gets one cache per
+  // time, and ancestors shared by neighbouring prims are resolved once per
+  // cache rather than per prim.
+  const size_t concurrency = std::max<size_t>(1, WorkGetConcurrencyLimit());
+  const size_t rangesPerTime = std::min(
+      prim_count, std::max<size_t>(1, (concurrency + time_count - 1) /
+                                          time_count));
+  WorkParallelForN(time_count * rangesPerTime, [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; ++task) {
+      const size_t timeIndex = task / rangesPerTime;
+      const size_t rangeIndex = task % rangesPerTime;
+      const size_t firstPrim = prim_count * rangeIndex / rangesPerTime;
+      const size_t lastPrim = prim_count * (rangeIndex + 1) / rangesPerTime;
+      const UsdTimeCode timeCode = time_codes
+                                       ? UsdTimeCode(time_codes[timeIndex])
+                                       : UsdTimeCode::Default();
+      UsdGeomBBoxCache bboxCache(timeCode, purposes, true);
+      int taskNonEmpty = 0;
+      for (size_t primIndex = firstPrim; primIndex < lastPrim; ++primIndex) {
+        GfRange3d range;
+        if (prims[primIndex].IsValid()) {
+          range = bboxCache.ComputeWorldBound(prims[primIndex])
+                      .ComputeAlignedRange();
+        }
+        WriteRange(range, out_bounds + (timeIndex * prim_count + primIndex) * 6);
+        if (!range.IsEmpty()) {
+          ++taskNonEmpty;
+        }
+      }
+      nonEmptyCount.fetch_add(taskNonEmpty, std::memory_order_relaxed);
+    }
+  }, 1);
+
+  return nonEmptyCount.load();
 }
 
 USDInteropSourceSiteList usdinterop_stage_prim_source_sites(
@@ -502,7 +1507,22 @@ USDInteropSourceSiteList usdinterop_stage_prim_source_sites(
     return result;
   }
 
-  UsdStageRefPtr stage = UsdStage::Open(std::string(stage_path), UsdStage::LoadAll);
+  ScopedStageHandle stage(usdinterop_stage_open(stage_path, USDINTEROP_LOAD_ALL));
+  return usdinterop_prim_source_sites_for_stage(stage.get(), prim_path);
+}
+
+USDInteropSourceSiteList usdinterop_prim_source_sites_for_stage(
+    const usdinterop_stage_t *handle,
+    const char *prim_path
+) {
+  USDInteropSourceSiteList result = {};
+
+  if (!prim_path || prim_path[0] == '\0') {
+    return result;
+  }
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
   if (!stage) {
     return result;
   }
@@ -526,7 +1546,22 @@ USDInteropSourceSiteList usdinterop_stage_property_source_sites(
     return result;
   }
 
-  UsdStageRefPtr stage = UsdStage::Open(std::string(stage_path), UsdStage::LoadAll);
+  ScopedStageHandle stage(usdinterop_stage_open(stage_path, USDINTEROP_LOAD_ALL));
+  return usdinterop_property_source_sites_for_stage(stage.get(), property_path);
+}
+
+USDInteropSourceSiteList usdinterop_property_source_sites_for_stage(
+    const usdinterop_stage_t *handle,
+    const char *property_path
+) {
+  USDInteropSourceSiteList result = {};
+
+  if (!property_path || property_path[0] == '\0') {
+    return result;
+  }
+
+  StageReadScope scope(handle);
+  const UsdStageRefPtr &stage = scope.Get();
   if (!stage) {
     return result;
   }
@@ -610,65 +1645,6 @@ int usdinterop_is_package_relative_path(const char *path) {
   return ArIsPackageRelativePath(std::string(path)) ? 1 : 0;
 }
 
-const unsigned char *usdinterop_read_asset_bytes(const char *asset_path,
-                                                 const char *anchor_asset_path,
-                                                 size_t *size) {
-  if (!asset_path || asset_path[0] == '\0' || !size) {
-    return nullptr;
-  }
-
-  *size = 0;
-
-  try {
-    ArResolver &resolver = ArGetResolver();
-
-    const std::string assetPath(asset_path);
-    const std::string anchorAssetPath =
-        (anchor_asset_path && anchor_asset_path[0] != '\0')
-            ? std::string(anchor_asset_path)
-            : std::string();
-
-    const std::string contextAssetPath =
-        !anchorAssetPath.empty() ? anchorAssetPath : assetPath;
-    ArResolverContext context =
-        resolver.CreateDefaultContextForAsset(contextAssetPath);
-    ArResolverContextBinder binder(&resolver, context);
-
-    const ArResolvedPath anchorResolvedPath =
-        !anchorAssetPath.empty() ? resolver.Resolve(anchorAssetPath)
-                                 : ArResolvedPath();
-    const std::string identifier =
-        resolver.CreateIdentifier(assetPath, anchorResolvedPath);
-    const ArResolvedPath resolvedPath = resolver.Resolve(identifier);
-    if (resolvedPath.empty()) {
-      return nullptr;
-    }
-
-    std::shared_ptr<ArAsset> asset = resolver.OpenAsset(resolvedPath);
-    if (!asset) {
-      return nullptr;
-    }
-
-    const size_t assetSize = asset->GetSize();
-    std::shared_ptr<const char> buffer = asset->GetBuffer();
-    if (!buffer && assetSize != 0) {
-      return nullptr;
-    }
-
-    const unsigned char *copied =
-        CopyToByteBuffer(buffer.get(), assetSize);
-    if (!copied) {
-      return nullptr;
-    }
-
-    *size = assetSize;
-    return copied;
-  } catch (...) {
-    *size = 0;
-    return nullptr;
-  }
-}
-
 void usdinterop_free_bytes(const void *value) {
   if (!value) {
     return;
@@ -0,0 +1,363 @@
+#include "USDInteropDependencyCache.hpp"
+
+#include "pxr/base/work/withScopedParallelism.h"
+#include "pxr/pxr.h"
+#include "pxr/usd/ar/packageUtils.h"
+#include "pxr/usd/ar/resolvedPath.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverScopedCache.h"
+#include "pxr/usd/sdf/fileFormat.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/layerUtils.h"
+#include "pxr/usd/usdUtils/dependencies.h"
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <unordered_set>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+constexpr const char *kCacheFileHeader = "usdinterop-dependency-cache 2";
+constexpr const char *kCacheFilePrefix = "usdinterop-dependency-cache ";
+
+bool IsLayerPath(const std::string &resolvedPath) {
+  return static_cast<bool>(SdfFileFormat::FindByExtension(resolvedPath));
+}
+
+/// Splits "<size> <modified> <path>" without touching spaces in the path.
+bool ParseStampLine(const std::string &line, int64_t &size, int64_t &modified,
+                    std::string &path) {
+  const size_t sizeEnd = line.find(' ', 2);
+  if (sizeEnd == std::string::npos) {
+    return false;
+  }
+  const size_t modifiedEnd = line.find(' ', sizeEnd + 1);
+  if (modifiedEnd == std::string::npos) {
+    return false;
+  }
+  try {
+    size = std::stoll(line.substr(2, sizeEnd - 2));
+    modified = std::stoll(line.substr(sizeEnd + 1, modifiedEnd - sizeEnd - 1));
+  } catch (...) {
+    return false;
+  }
+  path = line.substr(modifiedEnd + 1);
+  return !path.empty();
+}
+} // namespace
+
+namespace USDInteropInternal {
+DependencyCache &DependencyCache::GetInstance() {
+  static DependencyCache instance;
+  return instance;
+}
+
+DependencyCache::FileStamp
+DependencyCache::StatLayer(const std::string &layerPath) {
+  // Layers inside a package change together with the package file.
+  const std::string filePath =
+      ArIsPackageRelativePath(layerPath)
+          ? ArSplitPackageRelativePathOuter(layerPath).first
+          : layerPath;
+
+  FileStamp stamp;
+  std::error_code error;
+  const auto size = std::filesystem::file_size(filePath, error);
+  if (error) {
+    return stamp;
+  }
+  const auto modified = std::filesystem::last_write_time(filePath, error);
+  if (error) {
+    return stamp;
+  }
+  stamp.size = static_cast<int64_t>(size);
+  stamp.modified =
+      static_cast<int64_t>(modified.time_since_epoch().count());
+  return stamp;
+}
+
+std::shared_ptr<const DependencyCache::LayerEdges>
+DependencyCache::ExtractEdges(const std::string &layerPath,
+                              const FileStamp &stamp) {
+  auto edges = std::make_shared<LayerEdges>();
+  edges->stamp = stamp;
+
+  // Held open so anchoring sees the layer's own identifier, including any
+  // enclosing package. A copy already in the registry may carry unsaved
+  // edits, or predate the file when a stage kept it open across an external
+  // edit, and edges cached under the file's stamp must match the file. So
+  // the edges then come from a fresh, anonymous read of the file.
+  SdfLayerRefPtr layer = SdfLayer::Find(layerPath);
+  const bool wasLoaded = static_cast<bool>(layer);
+  if (!layer) {
+    layer = SdfLayer::FindOrOpen(layerPath);
+  }
+  if (!layer) {
+    return edges;
+  }
+  SdfLayerRefPtr contents = layer;
+  if (wasLoaded || layer->IsDirty()) {
+    contents = SdfLayer::OpenAsAnonymous(layerPath);
+    if (!contents) {
+      return edges;
+    }
+  }
+
+  // The identifier finds `contents` again, anonymous or not.
+  std::vector<std::string> subLayers;
+  std::vector<std::string> references;
+  std::vector<std::string> payloads;
+  UsdUtilsExtractExternalReferences(contents->GetIdentifier(), &subLayers,
+                                    &references, &payloads);
+
+  std::unordered_set<std::string> seen;
+  const auto addDependency = [&](const std::string &authoredPath,
+                                 std::vector<std::string> &out) {
+    // UDIM templates name a set of tiles rather than one file.
+    if (authoredPath.empty() ||
+        authoredPath.find("<UDIM>") != std::string::npos) {
+      return;
+    }
+    std::string identifier =
+        SdfComputeAssetPathRelativeToLayer(layer, authoredPath);
+    if (!identifier.empty() && seen.insert(identifier).second) {
+      out.push_back(std::move(identifier));
+    }
+  };
+
+  for (const std::string &path : subLayers) {
+    addDependency(path, edges->layers);
+  }
+  for (const std::string &path : payloads) {
+    addDependency(path, edges->layers);
+  }
+  // References also carry asset-valued attributes, so classify by format.
+  for (const std::string &path : references) {
+    addDependency(path, edges->references);
+  }
+  return edges;
+}
+
+std::shared_ptr<const DependencyCache::LayerEdges>
+DependencyCache::Edges(const std::string &layerPath) {
+  const FileStamp stamp = StatLayer(layerPath);
+  std::promise<std::shared_ptr<const LayerEdges>> promise;
+  std::shared_future<std::shared_ptr<const LayerEdges>> inFlight;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _edges.find(layerPath);
+    if (found != _edges.end() && found->second->stamp == stamp &&
+        stamp.size >= 0) {
+      return found->second;
+    }
+    const auto extracting = _extracting.find(layerPath);
+    if (extracting != _extracting.end()) {
+      inFlight = extracting->second;
+    } else {
+      _extracting.emplace(layerPath, promise.get_future().share());
+    }
+  }
+  if (inFlight.valid()) {
+    return inFlight.get();
+  }
+
+  // Extract outside the lock so walks over different layers overlap. Other
+  // Work tasks may be blocked on this extraction's future, so any parallel
+  // work it starts is isolated: a thread waiting inside it must not pick up
+  // an outer audit task that would block on the same future.
+  std::shared_ptr<const LayerEdges> edges;
+  try {
+    WorkWithScopedParallelism(
+        [&]() { edges = ExtractEdges(layerPath, stamp); });
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _extracting.erase(layerPath);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (stamp.size >= 0) {
+      _edges[layerPath] = edges;
+      _dirty = true;
+    }
+    _extracting.erase(layerPath);
+  }
+  promise.set_value(edges);
+  return edges;
+}
+
+DependencyWalk DependencyCache::Walk(const std::string &assetPath) {
+  DependencyWalk walk;
+  ArResolver &resolver = ArGetResolver();
+  // Edges are cached unresolved, so resolve them fresh for this walk but
+  // only once per identifier.
+  ArResolverScopedCache resolveCache;
+  const ArResolvedPath rootPath =
+      resolver.Resolve(resolver.CreateIdentifier(assetPath));
+  if (rootPath.empty()) {
+    walk.unresolved.push_back(assetPath);
+    return walk;
+  }
+  walk.rootResolved = true;
+
+  std::unordered_set<std::string> seenLayers{rootPath.GetPathString()};
+  std::unordered_set<std::string> seenAssets;
+  std::unordered_set<std::string> seenUnresolved;
+  std::vector<std::string> pending{rootPath.GetPathString()};
+  walk.layers.push_back(rootPath.GetPathString());
+
+  const auto follow = [&](const std::string &identifier, bool isLayer) {
+    const ArResolvedPath resolvedPath = resolver.Resolve(identifier);
+    if (resolvedPath.empty()) {
+      if (seenUnresolved.insert(identifier).second) {
+        walk.unresolved.push_back(identifier);
+      }
+      return;
+    }
+    const std::string &path = resolvedPath.GetPathString();
+    if (isLayer || IsLayerPath(path)) {
+      if (seenLayers.insert(path).second) {
+        walk.layers.push_back(path);
+        pending.push_back(path);
+      }
+    } else if (seenAssets.insert(path).second) {
+      walk.assets.push_back(path);
+    }
+  };
+
+  while (!pending.empty()) {
+    const std::string layerPath = std::move(pending.back());
+    pending.pop_back();
+
+    const std::shared_ptr<const LayerEdges> edges = Edges(layerPath);
+    for (const std::string &identifier : edges->layers) {
+      follow(identifier, true);
+    }
+    for (const std::string &identifier : edges->references) {
+      follow(identifier, false);
+    }
+  }
+
+  return walk;
+}
+
+bool DependencyCache::SetPersistentPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _persistentPath = path;
+  return path.empty() || LoadLocked();
+}
+
+bool DependencyCache::Save() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return SaveLocked();
+}
+
+void DependencyCache::Clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _edges.clear();
+  _dirty = !_persistentPath.empty();
+}
+
+bool DependencyCache::LoadLocked() {
+  std::ifstream input(_persistentPath);
+  if (!input) {
+    // Nothing persisted yet.
+    return true;
+  }
+
+  std::string line;
+  if (!std::getline(input, line) || line.rfind(kCacheFilePrefix, 0) != 0) {
+    return false;
+  }
+  if (line != kCacheFileHeader) {
+    // Written by another version; its edges are rebuilt and saved over it.
+    _dirty = true;
+    return true;
+  }
+
+  std::string layerPath;
+  std::shared_ptr<LayerEdges> current;
+  const auto commit = [&]() {
+    if (current) {
+      // Entries already validated in this process win over the file.
+      _edges.emplace(layerPath, std::move(current));
+    }
+  };
+
+  while (std::getline(input, line)) {
+    if (line.size() < 3 || line[1] != ' ') {
+      continue;
+    }
+    const std::string value = line.substr(2);
+    switch (line[0]) {
+      case 'L': {
+        commit();
+        current = std::make_shared<LayerEdges>();
+        if (!ParseStampLine(line, current->stamp.size, current->stamp.modified,
+                            layerPath)) {
+          current.reset();
+        }
+        break;
+      }
+      case 'S':
+        if (current) {
+          current->layers.push_back(value);
+        }
+        break;
+      case 'R':
+        if (current) {
+          current->references.push_back(value);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  commit();
+  return true;
+}
+
+bool DependencyCache::SaveLocked() {
+  if (_persistentPath.empty() || !_dirty) {
+    return true;
+  }
+
+  const std::string tempPath = _persistentPath + ".tmp";
+  {
+    std::ofstream output(tempPath, std::ios::trunc);
+    if (!output) {
+      return false;
+    }
+    output << kCacheFileHeader << '\n';
+    for (const auto &entry : _edges) {
+      const LayerEdges &edges = *entry.second;
+      output << "L " << edges.stamp.size << ' ' << edges.stamp.modified << ' '
+             << entry.first << '\n';
+      for (const std::string &path : edges.layers) {
+        output << "S " << path << '\n';
+      }
+      for (const std::string &path : edges.references) {
+        output << "R " << path << '\n';
+      }
+    }
+    if (!output.flush()) {
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tempPath.c_str(), _persistentPath.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  _dirty = false;
+  return true;
+}
+} // namespace USDInteropInternal
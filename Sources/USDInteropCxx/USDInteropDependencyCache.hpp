@@ -0,0 +1,91 @@
+#ifndef USDINTEROP_DEPENDENCY_CACHE_HPP
+#define USDINTEROP_DEPENDENCY_CACHE_HPP
+
+// Per-layer dependency edges behind `CheckDependenciesSimple`. Private to
+// USDInteropCxx.
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace USDInteropInternal {
+/// Everything reachable from one root asset.
+struct DependencyWalk {
+  bool rootResolved = false;
+  /// Resolved layer paths, root first.
+  std::vector<std::string> layers;
+  /// Resolved non-layer assets such as textures.
+  std::vector<std::string> assets;
+  /// Anchored asset paths that did not resolve.
+  std::vector<std::string> unresolved;
+};
+
+/// Caches each layer's direct sublayer, reference, payload and asset
+/// dependencies, keyed by the layer's real path and validated against its
+/// size and modification time. Only the anchored identifiers a layer authors
+/// are cached; they are resolved again on every walk, so adding or removing
+/// a dependency on disk is seen without the referencing layer changing. A
+/// walk re-extracts only layers whose file changed and follows cached edges
+/// for the rest. Safe to use concurrently; a layer shared by concurrent walks
+/// is extracted once while the other walks wait for its edges.
+class DependencyCache {
+ public:
+  static DependencyCache &GetInstance();
+
+  /// Resolves `assetPath` and walks its dependency graph. The caller is
+  /// expected to have bound a resolver context for the asset.
+  DependencyWalk Walk(const std::string &assetPath);
+
+  /// Loads cached edges from `path`; `Save` writes changes back to it. An
+  /// empty path keeps the cache in memory only. Returns false when an
+  /// existing file could not be read.
+  bool SetPersistentPath(const std::string &path);
+
+  /// Writes the cache to the persistent path if anything changed.
+  bool Save();
+
+  void Clear();
+
+ private:
+  struct FileStamp {
+    int64_t size = -1;
+    int64_t modified = 0;
+
+    bool operator==(const FileStamp &other) const {
+      return size == other.size && modified == other.modified;
+    }
+  };
+
+  /// Identifiers anchored to the layer as Sdf anchors them, so paths inside
+  /// a package stay inside it.
+  struct LayerEdges {
+    FileStamp stamp;
+    /// Sublayers and payloads, which are always layers.
+    std::vector<std::string> layers;
+    /// References and asset-valued attributes, classified once resolved.
+    std::vector<std::string> references;
+  };
+
+  static FileStamp StatLayer(const std::string &layerPath);
+  static std::shared_ptr<const LayerEdges>
+  ExtractEdges(const std::string &layerPath, const FileStamp &stamp);
+
+  std::shared_ptr<const LayerEdges> Edges(const std::string &layerPath);
+  bool LoadLocked();
+  bool SaveLocked();
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<const LayerEdges>> _edges;
+  std::unordered_map<std::string,
+                     std::shared_future<std::shared_ptr<const LayerEdges>>>
+      _extracting;
+  std::string _persistentPath;
+  bool _dirty = false;
+};
+} // namespace USDInteropInternal
+
+#endif // USDINTEROP_DEPENDENCY_CACHE_HPP
@@ -0,0 +1,68 @@
+#ifndef USDINTEROP_INTERNAL_HPP
+#define USDINTEROP_INTERNAL_HPP
+
+// Private helpers shared by the USDInteropCxx translation units. This header
+// lives outside `include/` so it never becomes part of the Swift module.
+
+#include "USDInteropCxx.h"
+
+#include "pxr/pxr.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace USDInteropInternal {
+/// Copies `value` into a malloc-owned C string freed by `usdinterop_free_string`.
+const char *CopyToCString(const std::string &value);
+
+/// Packs `values` into a `USDInteropStringList`: the pointer table followed
+/// by the string bytes, in one allocation. Null entries stay NULL. Returns an
+/// empty list when the allocation fails.
+USDInteropStringList
+CopyToStringList(const std::vector<const std::string *> &values);
+
+/// Returns the composed stage behind a handle, or null for a null handle.
+UsdStageRefPtr StageFromHandle(const usdinterop_stage_t *stage);
+
+/// Releases a stage handle when leaving scope. Used by the path-based entry
+/// points, which route through the stage cache instead of `UsdStage::Open`.
+class ScopedStageHandle {
+ public:
+  explicit ScopedStageHandle(usdinterop_stage_t *stage) : _stage(stage) {}
+  ~ScopedStageHandle() { usdinterop_stage_release(_stage); }
+
+  ScopedStageHandle(const ScopedStageHandle &) = delete;
+  ScopedStageHandle &operator=(const ScopedStageHandle &) = delete;
+
+  usdinterop_stage_t *get() const { return _stage; }
+  explicit operator bool() const { return _stage != nullptr; }
+
+ private:
+  usdinterop_stage_t *_stage;
+};
+
+/// Pins the stage behind a handle for the duration of a query. Layer reloads,
+/// whether from `usdinterop_stage_refresh` or from an open that finds a
+/// changed file, wait until no query holds a read scope, so a traversal never
+/// observes a half-reloaded layer stack.
+class StageReadScope {
+ public:
+  explicit StageReadScope(const usdinterop_stage_t *stage);
+  ~StageReadScope();
+
+  StageReadScope(const StageReadScope &) = delete;
+  StageReadScope &operator=(const StageReadScope &) = delete;
+
+  const UsdStageRefPtr &Get() const { return _stage; }
+
+ private:
+  std::shared_lock<std::shared_mutex> _lock;
+  UsdStageRefPtr _stage;
+};
+} // namespace USDInteropInternal
+
+#endif // USDINTEROP_INTERNAL_HPP
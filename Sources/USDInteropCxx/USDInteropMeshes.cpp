@@ -0,0 +1,467 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usd/timeCode.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/primvar.h"
+#include "pxr/usd/usdGeom/primvarsAPI.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformCache.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using USDInteropInternal::StageReadScope;
+
+namespace {
+/// One mesh's triangulated, world-space data before packing.
+struct MeshData {
+  std::string path;
+  std::vector<float> positions;
+  std::vector<float> normals;
+  std::vector<float> uvs;
+  std::vector<uint32_t> indices;
+  int flags = 0;
+};
+
+/// A primvar flattened through its indices, sampled per face, point or
+/// face-vertex according to its interpolation.
+template <typename T>
+struct PrimvarSamples {
+  VtArray<T> values;
+  TfToken interpolation;
+
+  bool IsValid() const { return !values.empty(); }
+
+  bool VariesPerFaceVertex() const {
+    return interpolation == UsdGeomTokens->faceVarying ||
+           interpolation == UsdGeomTokens->uniform;
+  }
+
+  const T *At(size_t face, size_t faceVertex, size_t point) const {
+    size_t index = point;
+    if (interpolation == UsdGeomTokens->constant) {
+      index = 0;
+    } else if (interpolation == UsdGeomTokens->uniform) {
+      index = face;
+    } else if (interpolation == UsdGeomTokens->faceVarying) {
+      index = faceVertex;
+    }
+    return index < values.size() ? &values[index] : nullptr;
+  }
+};
+
+template <typename T>
+bool ReadPrimvar(const UsdGeomPrimvar &primvar, UsdTimeCode time,
+                 PrimvarSamples<T> &samples) {
+  if (!primvar || !primvar.ComputeFlattened(&samples.values, time)) {
+    return false;
+  }
+  samples.interpolation = primvar.GetInterpolation();
+  return samples.IsValid();
+}
+
+/// `primvars:normals` overrides the `normals` attribute, as in
+/// UsdGeomPointBased.
+bool ReadNormals(const UsdGeomMesh &mesh, UsdTimeCode time,
+                 PrimvarSamples<GfVec3f> &samples) {
+  if (ReadPrimvar(UsdGeomPrimvarsAPI(mesh.GetPrim())
+                      .GetPrimvar(UsdGeomTokens->normals),
+                  time, samples)) {
+    return true;
+  }
+  if (!mesh.GetNormalsAttr().Get(&samples.values, time)) {
+    return false;
+  }
+  samples.interpolation = mesh.GetNormalsInterpolation();
+  return samples.IsValid();
+}
+
+bool IsHiddenOrNonRenderable(const UsdPrim &prim, UsdTimeCode time) {
+  const UsdGeomImageable imageable(prim);
+  if (!imageable) {
+    return false;
+  }
+  TfToken visibility;
+  if (imageable.GetVisibilityAttr().Get(&visibility, time) &&
+      visibility == UsdGeomTokens->invisible) {
+    return true;
+  }
+  TfToken purpose;
+  return imageable.GetPurposeAttr().Get(&purpose) &&
+         (purpose == UsdGeomTokens->proxy || purpose == UsdGeomTokens->guide);
+}
+
+/// Area-weighted smooth normals per point from point-space triangles.
+std::vector<float> ComputePointNormals(const VtVec3fArray &points,
+                                       const std::vector<uint32_t> &triangles) {
+  std::vector<float> normals(points.size() * 3, 0.0f);
+  const float *p = reinterpret_cast<const float *>(points.cdata());
+  float *n = normals.data();
+  for (size_t t = 0; t + 2 < triangles.size(); t += 3) {
+    const uint32_t a = triangles[t] * 3;
+    const uint32_t b = triangles[t + 1] * 3;
+    const uint32_t c = triangles[t + 2] * 3;
+    const float e1x = p[b] - p[a], e1y = p[b + 1] - p[a + 1],
+                e1z = p[b + 2] - p[a + 2];
+    const float e2x = p[c] - p[a], e2y = p[c + 1] - p[a + 1],
+                e2z = p[c + 2] - p[a + 2];
+    const float nx = e1y * e2z - e1z * e2y;
+    const float ny = e1z * e2x - e1x * e2z;
+    const float nz = e1x * e2y - e1y * e2x;
+    n[a] += nx, n[a + 1] += ny, n[a + 2] += nz;
+    n[b] += nx, n[b + 1] += ny, n[b + 2] += nz;
+    n[c] += nx, n[c + 1] += ny, n[c + 2] += nz;
+  }
+  return normals;
+}
+
+/// Transforms packed xyz positions by a row-vector matrix in place. Kept
+/// branch-free over contiguous floats so the compiler vectorizes it.
+void TransformPositions(const GfMatrix4d &matrix, std::vector<float> &xyz) {
+  float m[16];
+  const double *source = matrix.GetArray();
+  for (int i = 0; i < 16; ++i) {
+    m[i] = static_cast<float>(source[i]);
+  }
+  const size_t count = xyz.size() / 3;
+  float *v = xyz.data();
+  for (size_t i = 0; i < count; ++i) {
+    const float x = v[i * 3], y = v[i * 3 + 1], z = v[i * 3 + 2];
+    v[i * 3] = x * m[0] + y * m[4] + z * m[8] + m[12];
+    v[i * 3 + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+    v[i * 3 + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+  }
+}
+
+/// Transforms packed normals by the inverse transpose of `matrix` and
+/// normalizes them. Zero-length normals stay zero.
+void TransformNormals(const GfMatrix4d &matrix, std::vector<float> &xyz) {
+  const GfMatrix4d normalMatrix = matrix.GetInverse().GetTranspose();
+  float m[9];
+  for (int row = 0; row < 3; ++row) {
+    for (int column = 0; column < 3; ++column) {
+      m[row * 3 + column] = static_cast<float>(normalMatrix[row][column]);
+    }
+  }
+  const size_t count = xyz.size() / 3;
+  float *v = xyz.data();
+  for (size_t i = 0; i < count; ++i) {
+    const float x = v[i * 3], y = v[i * 3 + 1], z = v[i * 3 + 2];
+    const float nx = x * m[0] + y * m[3] + z * m[6];
+    const float ny = x * m[1] + y * m[4] + z * m[7];
+    const float nz = x * m[2] + y * m[5] + z * m[8];
+    const float lengthSquared = nx * nx + ny * ny + nz * nz;
+    const float scale = lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared)
+                                             : 0.0f;
+    v[i * 3] = nx * scale;
+    v[i * 3 + 1] = ny * scale;
+    v[i * 3 + 2] = nz * scale;
+  }
+}
+
+bool ExtractMesh(const UsdPrim &prim, UsdTimeCode time,
+                 UsdGeomXformCache &xformCache, MeshData &data) {
+  const UsdGeomMesh mesh(prim);
+  VtVec3fArray points;
+  VtIntArray faceVertexCounts;
+  VtIntArray faceVertexIndices;
+  if (!mesh.GetPointsAttr().Get(&points, time) ||
+      !mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts, time) ||
+      !mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices, time) ||
+      points.empty() || faceVertexCounts.empty()) {
+    return false;
+  }
+
+  size_t faceVertexTotal = 0;
+  for (const int count : faceVertexCounts) {
+    if (count < 0) {
+      return false;
+    }
+    faceVertexTotal += static_cast<size_t>(count);
+  }
+  if (faceVertexTotal != faceVertexIndices.size()) {
+    return false;
+  }
+  for (const int index : faceVertexIndices) {
+    if (index < 0 || static_cast<size_t>(index) >= points.size()) {
+      return false;
+    }
+  }
+
+  const GfMatrix4d localToWorld = xformCache.GetLocalToWorldTransform(prim);
+  TfToken orientation;
+  mesh.GetOrientationAttr().Get(&orientation, time);
+  // Emit counter-clockwise triangles in world space: left-handed meshes and
+  // mirroring transforms each reverse the authored winding.
+  const bool flipWinding = (orientation == UsdGeomTokens->leftHanded) !=
+                           (localToWorld.GetDeterminant() < 0.0);
+
+  PrimvarSamples<GfVec3f> normals;
+  const bool hasNormals = ReadNormals(mesh, time, normals);
+  PrimvarSamples<GfVec2f> uvs;
+  const bool hasUvs = ReadPrimvar(
+      UsdGeomPrimvarsAPI(prim).GetPrimvar(TfToken("st")), time, uvs);
+  const bool faceVarying = (hasNormals && normals.VariesPerFaceVertex()) ||
+                           (hasUvs && uvs.VariesPerFaceVertex());
+
+  // Fan-triangulate in face-vertex space, then map to points.
+  std::vector<uint32_t> faceVertexTriangles;
+  if (faceVertexTotal > faceVertexCounts.size() * 2) {
+    faceVertexTriangles.reserve(
+        (faceVertexTotal - faceVertexCounts.size() * 2) * 3);
+  }
+  std::vector<uint32_t> faceOfFaceVertex(faceVertexTotal);
+  size_t base = 0;
+  for (size_t face = 0; face < faceVertexCounts.size(); ++face) {
+    const size_t count = static_cast<size_t>(faceVertexCounts[face]);
+    for (size_t k = 0; k < count; ++k) {
+      faceOfFaceVertex[base + k] = static_cast<uint32_t>(face);
+    }
+    for (size_t k = 1; k + 1 < count; ++k) {
+      const uint32_t a = static_cast<uint32_t>(base);
+      const uint32_t b = static_cast<uint32_t>(base + k);
+      const uint32_t c = static_cast<uint32_t>(base + k + 1);
+      faceVertexTriangles.push_back(a);
+      faceVertexTriangles.push_back(flipWinding ? c : b);
+      faceVertexTriangles.push_back(flipWinding ? b : c);
+    }
+    base += count;
+  }
+
+  std::vector<uint32_t> pointTriangles(faceVertexTriangles.size());
+  for (size_t i = 0; i < faceVertexTriangles.size(); ++i) {
+    pointTriangles[i] =
+        static_cast<uint32_t>(faceVertexIndices[faceVertexTriangles[i]]);
+  }
+
+  std::vector<float> pointNormals;
+  if (!hasNormals) {
+    // Object-space winding matches the emitted triangles only when the
+    // transform does not mirror, so undo that part of the flip here.
+    std::vector<uint32_t> objectTriangles = pointTriangles;
+    if (localToWorld.GetDeterminant() < 0.0) {
+      for (size_t t = 0; t + 2 < objectTriangles.size(); t += 3) {
+        std::swap(objectTriangles[t + 1], objectTriangles[t + 2]);
+      }
+    }
+    pointNormals = ComputePointNormals(points, objectTriangles);
+    data.flags |= USDINTEROP_MESH_COMPUTED_NORMALS;
+  }
+  if (hasUvs) {
+    data.flags |= USDINTEROP_MESH_HAS_UVS;
+  }
+
+  const size_t vertexCount = faceVarying ? faceVertexTotal : points.size();
+  data.positions.resize(vertexCount * 3);
+  data.normals.assign(vertexCount * 3, 0.0f);
+  data.uvs.assign(vertexCount * 2, 0.0f);
+
+  const auto writeVertex = [&](size_t vertex, size_t face, size_t faceVertex,
+                               size_t point) {
+    const GfVec3f &position = points[point];
+    data.positions[vertex * 3] = position[0];
+    data.positions[vertex * 3 + 1] = position[1];
+    data.positions[vertex * 3 + 2] = position[2];
+    if (hasNormals) {
+      if (const GfVec3f *normal = normals.At(face, faceVertex, point)) {
+        data.normals[vertex * 3] = (*normal)[0];
+        data.normals[vertex * 3 + 1] = (*normal)[1];
+        data.normals[vertex * 3 + 2] = (*normal)[2];
+      }
+    } else {
+      data.normals[vertex * 3] = pointNormals[point * 3];
+      data.normals[vertex * 3 + 1] = pointNormals[point * 3 + 1];
+      data.normals[vertex * 3 + 2] = pointNormals[point * 3 + 2];
+    }
+    if (hasUvs) {
+      if (const GfVec2f *uv = uvs.At(face, faceVertex, point)) {
+        data.uvs[vertex * 2] = (*uv)[0];
+        data.uvs[vertex * 2 + 1] = (*uv)[1];
+      }
+    }
+  };
+
+  if (faceVarying) {
+    data.flags |= USDINTEROP_MESH_FACE_VARYING;
+    for (size_t faceVertex = 0; faceVertex < faceVertexTotal; ++faceVertex) {
+      writeVertex(faceVertex, faceOfFaceVertex[faceVertex], faceVertex,
+                  static_cast<size_t>(faceVertexIndices[faceVertex]));
+    }
+    data.indices = std::move(faceVertexTriangles);
+  } else {
+    // Vertex-interpolated data has no per-face or per-face-vertex values.
+    for (size_t point = 0; point < points.size(); ++point) {
+      writeVertex(point, 0, 0, point);
+    }
+    data.indices = std::move(pointTriangles);
+  }
+
+  TransformPositions(localToWorld, data.positions);
+  TransformNormals(localToWorld, data.normals);
+  data.path = prim.GetPath().GetString();
+  return !data.indices.empty();
+}
+
+/// Reserves `count` aligned elements of `T` at the end of a block layout and
+/// returns their offset.
+template <typename T>
+size_t ReserveInBlock(size_t &blockSize, size_t count) {
+  const size_t offset = (blockSize + alignof(T) - 1) & ~(alignof(T) - 1);
+  blockSize = offset + count * sizeof(T);
+  return offset;
+}
+} // namespace
+
+USDInteropMeshBuffers usdinterop_extract_meshes(
+    const usdinterop_stage_t *stage,
+    const char *root_prim_path,
+    const double *time_code) {
+  USDInteropMeshBuffers buffers = {};
+
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return buffers;
+    }
+
+    const UsdPrim root = root_prim_path && root_prim_path[0] != '\0'
+                             ? usdStage->GetPrimAtPath(SdfPath(root_prim_path))
+                             : usdStage->GetPseudoRoot();
+    if (!root) {
+      return buffers;
+    }
+    const UsdTimeCode time =
+        time_code ? UsdTimeCode(*time_code) : UsdTimeCode::Default();
+
+    std::vector<UsdPrim> meshPrims;
+    const UsdPrimRange range(root,
+                             UsdTraverseInstanceProxies(UsdPrimDefaultPredicate));
+    for (auto it = range.begin(); it != range.end(); ++it) {
+      if (IsHiddenOrNonRenderable(*it, time)) {
+        it.PruneChildren();
+        continue;
+      }
+      if (it->IsA<UsdGeomMesh>()) {
+        meshPrims.push_back(*it);
+      }
+    }
+
+    // A UsdGeomXformCache must not be shared between threads, so each chunk
+    // of meshes gets its own.
+    std::vector<MeshData> meshes(meshPrims.size());
+    std::vector<char> extracted(meshPrims.size(), 0);
+    WorkParallelForN(meshPrims.size(), [&](size_t begin, size_t end) {
+      UsdGeomXformCache xformCache(time);
+      for (size_t i = begin; i < end; ++i) {
+        try {
+          extracted[i] = ExtractMesh(meshPrims[i], time, xformCache, meshes[i]);
+        } catch (...) {
+          extracted[i] = 0;
+        }
+      }
+    });
+
+    std::vector<USDInteropMeshRange> ranges;
+    std::vector<size_t> sources;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    size_t textSize = 0;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+      if (!extracted[i]) {
+        continue;
+      }
+      const MeshData &mesh = meshes[i];
+      USDInteropMeshRange meshRange = {};
+      meshRange.firstVertex = static_cast<uint32_t>(vertexCount);
+      meshRange.vertexCount = static_cast<uint32_t>(mesh.positions.size() / 3);
+      meshRange.firstIndex = static_cast<uint32_t>(indexCount);
+      meshRange.indexCount = static_cast<uint32_t>(mesh.indices.size());
+      meshRange.flags = mesh.flags;
+      vertexCount += meshRange.vertexCount;
+      indexCount += meshRange.indexCount;
+      textSize += mesh.path.size() + 1;
+      ranges.push_back(meshRange);
+      sources.push_back(i);
+    }
+    if (ranges.empty() ||
+        vertexCount > std::numeric_limits<uint32_t>::max() ||
+        indexCount > std::numeric_limits<uint32_t>::max()) {
+      return buffers;
+    }
+
+    size_t blockSize = 0;
+    const size_t rangesOffset =
+        ReserveInBlock<USDInteropMeshRange>(blockSize, ranges.size());
+    const size_t positionsOffset =
+        ReserveInBlock<float>(blockSize, vertexCount * 3);
+    const size_t normalsOffset =
+        ReserveInBlock<float>(blockSize, vertexCount * 3);
+    const size_t uvsOffset = ReserveInBlock<float>(blockSize, vertexCount * 2);
+    const size_t indicesOffset =
+        ReserveInBlock<uint32_t>(blockSize, indexCount);
+    const size_t textOffset = ReserveInBlock<char>(blockSize, textSize);
+    char *block = static_cast<char *>(std::malloc(blockSize));
+    if (!block) {
+      return buffers;
+    }
+
+    buffers.meshes =
+        reinterpret_cast<USDInteropMeshRange *>(block + rangesOffset);
+    buffers.positions = reinterpret_cast<float *>(block + positionsOffset);
+    buffers.normals = reinterpret_cast<float *>(block + normalsOffset);
+    buffers.uvs = reinterpret_cast<float *>(block + uvsOffset);
+    buffers.indices = reinterpret_cast<uint32_t *>(block + indicesOffset);
+    char *text = block + textOffset;
+    for (size_t r = 0; r < ranges.size(); ++r) {
+      const std::string &path = meshes[sources[r]].path;
+      std::memcpy(text, path.c_str(), path.size() + 1);
+      ranges[r].primPath = text;
+      text += path.size() + 1;
+    }
+    std::memcpy(buffers.meshes, ranges.data(),
+                ranges.size() * sizeof(USDInteropMeshRange));
+
+    WorkParallelForN(ranges.size(), [&](size_t begin, size_t end) {
+      for (size_t r = begin; r < end; ++r) {
+        const MeshData &mesh = meshes[sources[r]];
+        const USDInteropMeshRange &meshRange = ranges[r];
+        std::memcpy(buffers.positions + meshRange.firstVertex * size_t(3),
+                    mesh.positions.data(), mesh.positions.size() * sizeof(float));
+        std::memcpy(buffers.normals + meshRange.firstVertex * size_t(3),
+                    mesh.normals.data(), mesh.normals.size() * sizeof(float));
+        std::memcpy(buffers.uvs + meshRange.firstVertex * size_t(2),
+                    mesh.uvs.data(), mesh.uvs.size() * sizeof(float));
+        std::memcpy(buffers.indices + meshRange.firstIndex, mesh.indices.data(),
+                    mesh.indices.size() * sizeof(uint32_t));
+      }
+    });
+
+    buffers.meshCount = ranges.size();
+    buffers.vertexCount = vertexCount;
+    buffers.indexCount = indexCount;
+    return buffers;
+  } catch (...) {
+    if (buffers.meshes) {
+      std::free(buffers.meshes);
+    }
+    return USDInteropMeshBuffers();
+  }
+}
+
+void usdinterop_free_mesh_buffers(USDInteropMeshBuffers buffers) {
+  // Every buffer lives in the allocation that starts with the range table.
+  std::free(buffers.meshes);
+}
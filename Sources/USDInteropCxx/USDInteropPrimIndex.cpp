@@ -0,0 +1,313 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/tf/token.h"
+#include "pxr/base/tf/type.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/usd/modelAPI.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usd/schemaRegistry.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using USDInteropInternal::StageReadScope;
+
+namespace {
+using PathSet = std::set<SdfPath>;
+using TokenIndex = std::unordered_map<TfToken, PathSet, TfToken::HashFunctor>;
+
+/// What a prim was indexed under, so it can be removed again.
+struct PrimEntry {
+  TfToken typeName;
+  TfToken kind;
+  TfTokenVector apiSchemas;
+  std::string foldedName;
+};
+
+void RemoveFromIndex(TokenIndex &index, const TfToken &key,
+                     const SdfPath &path) {
+  const auto found = index.find(key);
+  if (found == index.end()) {
+    return;
+  }
+  found->second.erase(path);
+  if (found->second.empty()) {
+    index.erase(found);
+  }
+}
+
+/// Appends up to `limit` paths of `paths` to `out`; 0 means no limit.
+void AppendPaths(const PathSet &paths, size_t limit,
+                 std::vector<SdfPath> &out) {
+  for (const SdfPath &path : paths) {
+    if (limit != 0 && out.size() >= limit) {
+      return;
+    }
+    out.push_back(path);
+  }
+}
+} // namespace
+
+struct usdinterop_prim_index_s : public TfWeakBase {
+  explicit usdinterop_prim_index_s(usdinterop_stage_t *handle)
+      : stageHandle(usdinterop_stage_retain(handle)) {}
+
+  ~usdinterop_prim_index_s() {
+    // Waits out a notice being delivered on an editing thread, which would
+    // otherwise run against the freed index.
+    TfNotice::RevokeAndWait(noticeKey);
+    usdinterop_stage_release(stageHandle);
+  }
+
+  usdinterop_stage_t *stageHandle;
+  UsdStageRefPtr stage;
+  TfNotice::Key noticeKey;
+
+  std::shared_mutex mutex;
+  // Ordered so a subtree is one contiguous range.
+  std::map<SdfPath, PrimEntry> entries;
+  TokenIndex byType;
+  TokenIndex byKind;
+  TokenIndex byApiSchema;
+  // Folded name -> paths. Sorted, so a prefix is one contiguous range.
+  std::map<std::string, PathSet> byName;
+
+  void Build() {
+    // Listen before traversing, under the same lock, so an edit made while
+    // building is applied once the initial index exists instead of lost.
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    noticeKey = TfNotice::Register(TfCreateWeakPtr(this),
+                                   &usdinterop_prim_index_s::OnObjectsChanged,
+                                   UsdStageWeakPtr(stage));
+    IndexSubtree(stage->GetPseudoRoot());
+  }
+
+  void OnObjectsChanged(const UsdNotice::ObjectsChanged &notice) {
+    // Notices arrive on the editing thread while it holds the stage, so the
+    // stage is read directly rather than through a StageReadScope.
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (const SdfPath &path : notice.GetResyncedPaths()) {
+      if (!path.IsAbsoluteRootOrPrimPath()) {
+        continue;
+      }
+      RemoveSubtree(path);
+      const UsdPrim prim = stage->GetPrimAtPath(path);
+      if (prim && IsIndexedSubtree(prim)) {
+        IndexSubtree(prim);
+      }
+    }
+    // Kind is prim metadata and changes without a resync.
+    for (const SdfPath &path : notice.GetChangedInfoOnlyPaths()) {
+      if (!path.IsPrimPath()) {
+        continue;
+      }
+      const auto found = entries.find(path);
+      const UsdPrim prim = stage->GetPrimAtPath(path);
+      if (found != entries.end() && prim) {
+        Remove(found);
+        Add(prim);
+      }
+    }
+  }
+
+  std::vector<SdfPath> Query(USDInteropPrimIndexKey key,
+                             const std::string &value, size_t limit) {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<SdfPath> paths;
+    switch (key) {
+      case USDINTEROP_PRIM_INDEX_TYPE:
+        return QueryType(TfToken(value), limit);
+      case USDINTEROP_PRIM_INDEX_KIND:
+        QueryExact(byKind, TfToken(value), limit, paths);
+        break;
+      case USDINTEROP_PRIM_INDEX_API_SCHEMA:
+        QueryExact(byApiSchema, TfToken(value), limit, paths);
+        break;
+      case USDINTEROP_PRIM_INDEX_NAME_PREFIX:
+        return QueryNamePrefix(TfStringToLowerAscii(value), limit);
+    }
+    return paths;
+  }
+
+ private:
+  static bool IsIndexedSubtree(const UsdPrim &prim) {
+    // Same filter as the default traversal, applied to the subtree root and
+    // its ancestors, which the resync may not have touched.
+    for (UsdPrim current = prim; current && !current.IsPseudoRoot();
+         current = current.GetParent()) {
+      if (!UsdPrimDefaultPredicate(current)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void IndexSubtree(const UsdPrim &root) {
+    for (const UsdPrim &prim : UsdPrimRange(root)) {
+      if (!prim.IsPseudoRoot()) {
+        Add(prim);
+      }
+    }
+  }
+
+  void Add(const UsdPrim &prim) {
+    const SdfPath &path = prim.GetPath();
+    // A prim can be reached twice when an edit lands while building.
+    const auto existing = entries.find(path);
+    if (existing != entries.end()) {
+      Remove(existing);
+    }
+    PrimEntry entry;
+    entry.typeName = prim.GetTypeName();
+    UsdModelAPI(prim).GetKind(&entry.kind);
+    entry.apiSchemas = prim.GetAppliedSchemas();
+    entry.foldedName = TfStringToLowerAscii(prim.GetName().GetString());
+
+    if (!entry.typeName.IsEmpty()) {
+      byType[entry.typeName].insert(path);
+    }
+    if (!entry.kind.IsEmpty()) {
+      byKind[entry.kind].insert(path);
+    }
+    for (const TfToken &schema : entry.apiSchemas) {
+      byApiSchema[schema].insert(path);
+    }
+    byName[entry.foldedName].insert(path);
+    entries[path] = std::move(entry);
+  }
+
+  void Remove(std::map<SdfPath, PrimEntry>::iterator found) {
+    const SdfPath &path = found->first;
+    const PrimEntry &entry = found->second;
+    RemoveFromIndex(byType, entry.typeName, path);
+    RemoveFromIndex(byKind, entry.kind, path);
+    for (const TfToken &schema : entry.apiSchemas) {
+      RemoveFromIndex(byApiSchema, schema, path);
+    }
+    const auto name = byName.find(entry.foldedName);
+    if (name != byName.end()) {
+      name->second.erase(path);
+      if (name->second.empty()) {
+        byName.erase(name);
+      }
+    }
+    entries.erase(found);
+  }
+
+  void RemoveSubtree(const SdfPath &root) {
+    auto it = entries.lower_bound(root);
+    while (it != entries.end() && it->first.HasPrefix(root)) {
+      auto next = std::next(it);
+      Remove(it);
+      it = next;
+    }
+  }
+
+  static void QueryExact(const TokenIndex &index, const TfToken &key,
+                         size_t limit, std::vector<SdfPath> &out) {
+    const auto found = index.find(key);
+    if (found != index.end()) {
+      AppendPaths(found->second, limit, out);
+    }
+  }
+
+  std::vector<SdfPath> QueryType(const TfToken &typeName, size_t limit) {
+    const TfType schemaType =
+        UsdSchemaRegistry::GetTypeFromSchemaTypeName(typeName);
+    std::vector<SdfPath> paths;
+    if (schemaType.IsUnknown()) {
+      QueryExact(byType, typeName, limit, paths);
+      return paths;
+    }
+
+    // Few distinct types exist on a stage, so matching derived types by
+    // checking each indexed type is cheap; results are then merged in path
+    // order.
+    std::vector<const PathSet *> matches;
+    for (const auto &entry : byType) {
+      if (UsdSchemaRegistry::GetTypeFromSchemaTypeName(entry.first)
+              .IsA(schemaType)) {
+        matches.push_back(&entry.second);
+      }
+    }
+    for (const PathSet *match : matches) {
+      paths.insert(paths.end(), match->begin(), match->end());
+    }
+    std::sort(paths.begin(), paths.end());
+    if (limit != 0 && paths.size() > limit) {
+      paths.resize(limit);
+    }
+    return paths;
+  }
+
+  std::vector<SdfPath> QueryNamePrefix(const std::string &prefix,
+                                       size_t limit) {
+    std::vector<SdfPath> paths;
+    for (auto it = byName.lower_bound(prefix);
+         it != byName.end() && TfStringStartsWith(it->first, prefix); ++it) {
+      paths.insert(paths.end(), it->second.begin(), it->second.end());
+    }
+    std::sort(paths.begin(), paths.end());
+    if (limit != 0 && paths.size() > limit) {
+      paths.resize(limit);
+    }
+    return paths;
+  }
+};
+
+usdinterop_prim_index_t *usdinterop_prim_index_create(
+    usdinterop_stage_t *stage) {
+  if (!stage) {
+    return nullptr;
+  }
+
+  usdinterop_prim_index_t *index = nullptr;
+  try {
+    StageReadScope scope(stage);
+    if (!scope.Get()) {
+      return nullptr;
+    }
+    index = new usdinterop_prim_index_s(stage);
+    index->stage = scope.Get();
+    index->Build();
+    return index;
+  } catch (...) {
+    delete index;
+    return nullptr;
+  }
+}
+
+void usdinterop_prim_index_destroy(usdinterop_prim_index_t *index) {
+  delete index;
+}
+
+USDInteropStringList usdinterop_prim_index_query(
+    usdinterop_prim_index_t *index,
+    USDInteropPrimIndexKey key,
+    const char *value,
+    size_t limit) {
+  if (!index || !value) {
+    return USDInteropStringList{};
+  }
+  try {
+    const std::vector<SdfPath> paths = index->Query(key, value, limit);
+    std::vector<const std::string *> values;
+    values.reserve(paths.size());
+    for (const SdfPath &path : paths) {
+      values.push_back(&path.GetString());
+    }
+    return USDInteropInternal::CopyToStringList(values);
+  } catch (...) {
+    return USDInteropStringList{};
+  }
+}
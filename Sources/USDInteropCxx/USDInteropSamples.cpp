@@ -0,0 +1,281 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/gf/half.h"
+#include "pxr/base/gf/matrix2d.h"
+#include "pxr/base/gf/matrix3d.h"
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/quatd.h"
+#include "pxr/base/gf/quatf.h"
+#include "pxr/base/gf/quath.h"
+#include "pxr/base/gf/traits.h"
+#include "pxr/base/gf/vec2d.h"
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec2h.h"
+#include "pxr/base/gf/vec2i.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec3h.h"
+#include "pxr/base/gf/vec3i.h"
+#include "pxr/base/gf/vec4d.h"
+#include "pxr/base/gf/vec4f.h"
+#include "pxr/base/gf/vec4h.h"
+#include "pxr/base/gf/vec4i.h"
+#include "pxr/base/tf/type.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/timeCode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using USDInteropInternal::StageReadScope;
+
+namespace {
+// Frames per parallel task, so short clips of many attributes and long clips
+// of a few attributes both spread across threads.
+constexpr size_t kFramesPerTask = 64;
+// Upper bound on frames per call; longer ranges are rejected rather than
+// risking a result too large to allocate.
+constexpr size_t kMaxFrameCount = size_t(1) << 24;
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+StoreComponents(const T &value, double *out) {
+  out[0] = static_cast<double>(value);
+}
+
+inline void StoreComponents(const GfHalf &value, double *out) {
+  out[0] = static_cast<double>(static_cast<float>(value));
+}
+
+template <typename T>
+typename std::enable_if<GfIsGfVec<T>::value>::type
+StoreComponents(const T &value, double *out) {
+  for (size_t i = 0; i < T::dimension; ++i) {
+    out[i] = static_cast<double>(value[i]);
+  }
+}
+
+template <typename T>
+typename std::enable_if<GfIsGfQuat<T>::value>::type
+StoreComponents(const T &value, double *out) {
+  const auto &imaginary = value.GetImaginary();
+  out[0] = static_cast<double>(imaginary[0]);
+  out[1] = static_cast<double>(imaginary[1]);
+  out[2] = static_cast<double>(imaginary[2]);
+  out[3] = static_cast<double>(value.GetReal());
+}
+
+template <typename T>
+typename std::enable_if<GfIsGfMatrix<T>::value>::type
+StoreComponents(const T &value, double *out) {
+  const auto *elements = value.GetArray();
+  for (size_t i = 0; i < T::numRows * T::numColumns; ++i) {
+    out[i] = static_cast<double>(elements[i]);
+  }
+}
+
+template <typename T>
+void SampleRange(const UsdAttributeQuery &query, const double *times,
+                 size_t frameCount, uint32_t components, double *out) {
+  // Typed reads skip the VtValue box a generic Get would allocate.
+  T value;
+  for (size_t f = 0; f < frameCount; ++f) {
+    double *sample = out + f * components;
+    if (query.Get(&value, UsdTimeCode(times[f]))) {
+      StoreComponents(value, sample);
+    } else {
+      std::fill(sample, sample + components,
+                std::numeric_limits<double>::quiet_NaN());
+    }
+  }
+}
+
+typedef void (*SampleRangeFn)(const UsdAttributeQuery &, const double *,
+                              size_t, uint32_t, double *);
+
+struct SampledType {
+  TfType type;
+  uint32_t components;
+  SampleRangeFn sample;
+};
+
+template <typename T>
+SampledType MakeSampledType(uint32_t components) {
+  return SampledType{TfType::Find<T>(), components, &SampleRange<T>};
+}
+
+const std::vector<SampledType> &SampledTypes() {
+  static const std::vector<SampledType> types = {
+      MakeSampledType<float>(1),       MakeSampledType<double>(1),
+      MakeSampledType<GfHalf>(1),      MakeSampledType<int>(1),
+      MakeSampledType<unsigned int>(1), MakeSampledType<int64_t>(1),
+      MakeSampledType<uint64_t>(1),    MakeSampledType<unsigned char>(1),
+      MakeSampledType<bool>(1),        MakeSampledType<GfVec2f>(2),
+      MakeSampledType<GfVec3f>(3),     MakeSampledType<GfVec4f>(4),
+      MakeSampledType<GfVec2d>(2),     MakeSampledType<GfVec3d>(3),
+      MakeSampledType<GfVec4d>(4),     MakeSampledType<GfVec2h>(2),
+      MakeSampledType<GfVec3h>(3),     MakeSampledType<GfVec4h>(4),
+      MakeSampledType<GfVec2i>(2),     MakeSampledType<GfVec3i>(3),
+      MakeSampledType<GfVec4i>(4),     MakeSampledType<GfQuatf>(4),
+      MakeSampledType<GfQuatd>(4),     MakeSampledType<GfQuath>(4),
+      MakeSampledType<GfMatrix2d>(4),  MakeSampledType<GfMatrix3d>(9),
+      MakeSampledType<GfMatrix4d>(16),
+  };
+  return types;
+}
+
+const SampledType *FindSampledType(const UsdAttribute &attr) {
+  const TfType type = attr.GetTypeName().GetType();
+  for (const SampledType &candidate : SampledTypes()) {
+    if (candidate.type == type) {
+      return &candidate;
+    }
+  }
+  return nullptr;
+}
+
+/// Returns the number of frames from `start_time` through `end_time`, or 0
+/// when the range is not finite or exceeds `kMaxFrameCount`.
+size_t FrameCount(double start_time, double end_time, double stride) {
+  if (!std::isfinite(start_time) || !std::isfinite(end_time) ||
+      !std::isfinite(stride)) {
+    return 0;
+  }
+  if (!(stride > 0.0) || !(end_time > start_time)) {
+    return 1;
+  }
+  // Tolerate rounding so an end time on the stride grid is included.
+  const double steps = std::floor((end_time - start_time) / stride + 1e-9);
+  if (!(steps < static_cast<double>(kMaxFrameCount))) {
+    return 0;
+  }
+  return static_cast<size_t>(steps) + 1;
+}
+
+/// `*out = a * b + c`, returning false on overflow.
+bool MultiplyAdd(size_t a, size_t b, size_t c, size_t *out) {
+  if (b != 0 && a > (std::numeric_limits<size_t>::max() - c) / b) {
+    return false;
+  }
+  *out = a * b + c;
+  return true;
+}
+} // namespace
+
+USDInteropAttributeSamples usdinterop_sample_attributes(
+    const usdinterop_stage_t *stage,
+    const char *const *attribute_paths,
+    size_t attribute_count,
+    double start_time,
+    double end_time,
+    double stride) {
+  USDInteropAttributeSamples samples = {};
+  const size_t frameCount = FrameCount(start_time, end_time, stride);
+  if ((!attribute_paths && attribute_count > 0) || frameCount == 0) {
+    return samples;
+  }
+
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return samples;
+    }
+
+    std::vector<UsdAttributeQuery> queries(attribute_count);
+    std::vector<const SampledType *> types(attribute_count, nullptr);
+    WorkParallelForN(attribute_count, [&](size_t begin, size_t end) {
+      for (size_t a = begin; a < end; ++a) {
+        const char *path = attribute_paths[a];
+        if (!path || path[0] == '\0' || !SdfPath::IsValidPathString(path)) {
+          continue;
+        }
+        const UsdAttribute attr = usdStage->GetAttributeAtPath(SdfPath(path));
+        if (!attr) {
+          continue;
+        }
+        types[a] = FindSampledType(attr);
+        if (types[a]) {
+          queries[a] = UsdAttributeQuery(attr);
+        }
+      }
+    });
+
+    size_t valueCount = 0;
+    std::vector<size_t> columnOffsets(attribute_count);
+    for (size_t a = 0; a < attribute_count; ++a) {
+      columnOffsets[a] = valueCount;
+      if (types[a] && !MultiplyAdd(frameCount, types[a]->components,
+                                   valueCount, &valueCount)) {
+        return samples;
+      }
+    }
+
+    size_t blockSize = 0;
+    if (!MultiplyAdd(frameCount, 1, valueCount, &blockSize) ||
+        !MultiplyAdd(blockSize, sizeof(double), 0, &blockSize) ||
+        !MultiplyAdd(attribute_count, sizeof(size_t) + sizeof(uint32_t),
+                     blockSize, &blockSize)) {
+      return samples;
+    }
+    char *block = static_cast<char *>(std::malloc(blockSize));
+    if (!block) {
+      return samples;
+    }
+    samples.attributeCount = attribute_count;
+    samples.frameCount = frameCount;
+    samples.times = reinterpret_cast<double *>(block);
+    samples.values = samples.times + frameCount;
+    samples.columnOffsets =
+        reinterpret_cast<size_t *>(samples.values + valueCount);
+    samples.componentCounts =
+        reinterpret_cast<uint32_t *>(samples.columnOffsets + attribute_count);
+
+    for (size_t f = 0; f < frameCount; ++f) {
+      samples.times[f] =
+          frameCount == 1
+              ? start_time
+              : std::min(start_time + static_cast<double>(f) * stride,
+                         end_time);
+    }
+    for (size_t a = 0; a < attribute_count; ++a) {
+      samples.columnOffsets[a] = columnOffsets[a];
+      samples.componentCounts[a] = types[a] ? types[a]->components : 0;
+    }
+
+    const size_t frameBlocks =
+        (frameCount + kFramesPerTask - 1) / kFramesPerTask;
+    WorkParallelForN(
+        attribute_count * frameBlocks, [&](size_t begin, size_t end) {
+          for (size_t task = begin; task < end; ++task) {
+            const size_t a = task / frameBlocks;
+            if (!types[a]) {
+              continue;
+            }
+            const size_t firstFrame = (task % frameBlocks) * kFramesPerTask;
+            const size_t frames =
+                std::min(kFramesPerTask, frameCount - firstFrame);
+            const uint32_t components = types[a]->components;
+            types[a]->sample(queries[a], samples.times + firstFrame, frames,
+                             components,
+                             samples.values + columnOffsets[a] +
+                                 firstFrame * components);
+          }
+        });
+    return samples;
+  } catch (...) {
+    std::free(samples.times);
+    return USDInteropAttributeSamples();
+  }
+}
+
+void usdinterop_free_attribute_samples(USDInteropAttributeSamples samples) {
+  // Every array lives in the allocation that starts with `times`.
+  std::free(samples.times);
+}
@@ -0,0 +1,182 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/property.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using USDInteropInternal::StageReadScope;
+
+namespace {
+/// A site before interning: the layer and spec path it refers to.
+struct CollectedSite {
+  SdfLayerHandle layer;
+  SdfPath specPath;
+  int role;
+};
+
+template <typename HandleVector>
+void CollectSites(const HandleVector &specStack,
+                  std::vector<CollectedSite> &out) {
+  for (size_t index = 0; index < specStack.size(); ++index) {
+    const auto &spec = specStack[index];
+    if (!spec) {
+      continue;
+    }
+    SdfLayerHandle layer = spec->GetLayer();
+    if (!layer) {
+      continue;
+    }
+    // Same role numbering as `MakeSourceSiteList`.
+    out.push_back({layer, spec->GetPath(), index == 0 ? 0 : 1});
+  }
+}
+
+void CollectPathSites(const UsdStage &stage, const char *text,
+                      std::vector<CollectedSite> &out) {
+  if (!text || text[0] == '\0' || !SdfPath::IsValidPathString(text)) {
+    return;
+  }
+  const SdfPath path(text);
+  if (path.IsPrimPath()) {
+    const UsdPrim prim = stage.GetPrimAtPath(path);
+    if (prim) {
+      CollectSites(prim.GetPrimStack(), out);
+    }
+  } else if (path.IsPropertyPath()) {
+    const UsdProperty property = stage.GetPropertyAtPath(path);
+    if (property.IsDefined()) {
+      CollectSites(property.GetPropertyStack(UsdTimeCode::Default()), out);
+    }
+  }
+}
+
+USDInteropSourceSiteBatch
+PackSourceSites(const std::vector<std::vector<CollectedSite>> &perPath) {
+  // Layers and spec paths repeat across sites, so each distinct one is
+  // stored once and shared.
+  std::unordered_map<const SdfLayer *, uint32_t> layerIndices;
+  std::vector<SdfLayerHandle> layers;
+  std::unordered_map<SdfPath, size_t, SdfPath::Hash> specIndices;
+  std::vector<SdfPath> specPaths;
+  std::vector<uint32_t> siteLayers;
+  std::vector<size_t> siteSpecs;
+  size_t siteCount = 0;
+  size_t textSize = 0;
+
+  for (const std::vector<CollectedSite> &sites : perPath) {
+    for (const CollectedSite &site : sites) {
+      const auto layer = layerIndices.emplace(
+          get_pointer(site.layer), static_cast<uint32_t>(layers.size()));
+      if (layer.second) {
+        layers.push_back(site.layer);
+        textSize += site.layer->GetIdentifier().size() + 1;
+        textSize += site.layer->GetRealPath().size() + 1;
+      }
+      const auto spec = specIndices.emplace(site.specPath, specPaths.size());
+      if (spec.second) {
+        specPaths.push_back(site.specPath);
+        textSize += site.specPath.GetString().size() + 1;
+      }
+      siteLayers.push_back(layer.first->second);
+      siteSpecs.push_back(spec.first->second);
+      ++siteCount;
+    }
+  }
+
+  const size_t pathCount = perPath.size();
+  const size_t blockSize = 2 * pathCount * sizeof(size_t) +
+                           siteCount * sizeof(USDInteropSourceSiteEntry) +
+                           layers.size() * sizeof(USDInteropSourceLayer) +
+                           textSize;
+  char *block = static_cast<char *>(std::malloc(blockSize));
+  if (!block) {
+    return USDInteropSourceSiteBatch{};
+  }
+
+  USDInteropSourceSiteBatch batch = {};
+  batch.pathCount = pathCount;
+  batch.siteCount = siteCount;
+  batch.layerCount = layers.size();
+  batch.firstSites = reinterpret_cast<size_t *>(block);
+  batch.siteCounts = batch.firstSites + pathCount;
+  batch.sites = reinterpret_cast<USDInteropSourceSiteEntry *>(
+      batch.siteCounts + pathCount);
+  batch.layers =
+      reinterpret_cast<USDInteropSourceLayer *>(batch.sites + siteCount);
+  char *text = reinterpret_cast<char *>(batch.layers + layers.size());
+
+  auto copyString = [&text](const std::string &value) -> const char * {
+    if (value.empty()) {
+      return nullptr;
+    }
+    const char *copy = text;
+    std::memcpy(text, value.c_str(), value.size() + 1);
+    text += value.size() + 1;
+    return copy;
+  };
+
+  for (size_t i = 0; i < layers.size(); ++i) {
+    batch.layers[i].identifier = copyString(layers[i]->GetIdentifier());
+    batch.layers[i].realPath = copyString(layers[i]->GetRealPath());
+  }
+  std::vector<const char *> specStrings(specPaths.size());
+  for (size_t i = 0; i < specPaths.size(); ++i) {
+    specStrings[i] = copyString(specPaths[i].GetString());
+  }
+
+  size_t site = 0;
+  for (size_t p = 0; p < pathCount; ++p) {
+    batch.firstSites[p] = site;
+    batch.siteCounts[p] = perPath[p].size();
+    for (const CollectedSite &collected : perPath[p]) {
+      USDInteropSourceSiteEntry &entry = batch.sites[site];
+      entry.layerIndex = siteLayers[site];
+      entry.role = collected.role;
+      entry.kind = 0; // unknown until we add canonical arc classification.
+      entry.specPath = specStrings[siteSpecs[site]];
+      ++site;
+    }
+  }
+  return batch;
+}
+} // namespace
+
+USDInteropSourceSiteBatch usdinterop_source_sites_batch(
+    const usdinterop_stage_t *stage,
+    const char *const *paths,
+    size_t path_count) {
+  if (!paths || path_count == 0) {
+    return USDInteropSourceSiteBatch{};
+  }
+
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return USDInteropSourceSiteBatch{};
+    }
+
+    std::vector<std::vector<CollectedSite>> perPath(path_count);
+    WorkParallelForN(path_count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        CollectPathSites(*usdStage, paths[i], perPath[i]);
+      }
+    });
+    return PackSourceSites(perPath);
+  } catch (...) {
+    return USDInteropSourceSiteBatch{};
+  }
+}
+
+void usdinterop_free_source_site_batch(USDInteropSourceSiteBatch batch) {
+  // Every array and string lives in the allocation that starts with
+  // `firstSites`.
+  std::free(batch.firstSites);
+}
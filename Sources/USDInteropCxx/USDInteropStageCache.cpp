@@ -0,0 +1,465 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/usd/ar/resolvedPath.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/timestamp.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/stageCache.h"
+#include "pxr/usd/usd/stagePopulationMask.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+// Enough for an inspector working across a handful of documents without
+// pinning every stage a long-running process has ever touched.
+constexpr size_t kDefaultStageCacheCapacity = 8;
+
+// Reloading a layer is visible to every stage that uses it, so refreshes
+// take this exclusively while queries hold it shared.
+std::shared_mutex g_layerReloadMutex;
+
+// Read scopes held by the current thread. Nested scopes do not relock, and
+// a refresh requested from inside a query is skipped instead of deadlocking.
+thread_local int t_readScopeDepth = 0;
+
+double LayerModificationStamp(const SdfLayerHandle &layer) {
+  if (!layer || layer->IsAnonymous()) {
+    return 0.0;
+  }
+  try {
+    const ArResolvedPath &resolvedPath = layer->GetResolvedPath();
+    if (resolvedPath.empty()) {
+      return 0.0;
+    }
+    const ArTimestamp timestamp = ArGetResolver().GetModificationTimestamp(
+        resolvedPath.GetPathString(), resolvedPath);
+    return timestamp.IsValid() ? timestamp.GetTime() : 0.0;
+  } catch (...) {
+    return 0.0;
+  }
+}
+
+/// Modification stamps of the files behind layers, as of when each layer's
+/// contents were last read. Stamps belong to layers rather than stages: the
+/// layer registry shares one layer between every stage that uses it, so a
+/// reload through one stage brings all of them up to date.
+class LayerStampRegistry {
+ public:
+  static LayerStampRegistry &GetInstance() {
+    static LayerStampRegistry instance;
+    return instance;
+  }
+
+  /// Stamps `layers` that were loaded by an open that just returned, i.e.
+  /// that are not in `preexisting`. Layers that were already in memory keep
+  /// whatever stamp they were loaded with, or none if this library never
+  /// saw them load, so a stale copy is never marked current.
+  void RecordOpened(const SdfLayerHandleVector &layers,
+                    const SdfLayerHandleSet &preexisting) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const SdfLayerHandle &layer : layers) {
+      if (!layer || layer->IsAnonymous() || preexisting.count(layer)) {
+        continue;
+      }
+      _stamps[get_pointer(layer)] = Stamp{layer, LayerModificationStamp(layer)};
+    }
+  }
+
+  /// Returns the layers whose file stamp differs from the one they were
+  /// loaded with, or that have no known load stamp, each paired with its
+  /// current stamp. Layers with unsaved edits are left out.
+  std::vector<std::pair<SdfLayerHandle, double>>
+  Changed(const SdfLayerHandleVector &layers) {
+    // Stat outside the lock; opens of unrelated stages check concurrently.
+    std::vector<std::pair<SdfLayerHandle, double>> current;
+    current.reserve(layers.size());
+    for (const SdfLayerHandle &layer : layers) {
+      if (layer && !layer->IsAnonymous() && !layer->IsDirty()) {
+        current.emplace_back(layer, LayerModificationStamp(layer));
+      }
+    }
+
+    std::vector<std::pair<SdfLayerHandle, double>> changed;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &entry : current) {
+      const auto found = _stamps.find(get_pointer(entry.first));
+      // A dead handle means the address was reused by a newer layer.
+      if (found == _stamps.end() || found->second.layer != entry.first ||
+          found->second.stamp != entry.second) {
+        changed.push_back(std::move(entry));
+      }
+    }
+    return changed;
+  }
+
+  /// Records stamps taken before a successful reload of their layers.
+  void Commit(const std::vector<std::pair<SdfLayerHandle, double>> &stamps) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto &entry : stamps) {
+      if (entry.first) {
+        _stamps[get_pointer(entry.first)] = Stamp{entry.first, entry.second};
+      }
+    }
+    // Drop entries for layers that have since been destroyed.
+    for (auto it = _stamps.begin(); it != _stamps.end();) {
+      it = it->second.layer ? std::next(it) : _stamps.erase(it);
+    }
+  }
+
+ private:
+  struct Stamp {
+    SdfLayerHandle layer;
+    double stamp = 0.0;
+  };
+
+  std::mutex _mutex;
+  std::unordered_map<const SdfLayer *, Stamp> _stamps;
+};
+
+/// A composed stage shared by the cache entry and every handle to it.
+struct StageState {
+  explicit StageState(UsdStageRefPtr composed) : stage(std::move(composed)) {}
+
+  UsdStageRefPtr stage;
+};
+
+/// Returned by `RefreshLayers` when the calling thread is inside a query.
+constexpr int kRefreshInsideQuery = -2;
+
+/// Reloads the layers among `layers` whose file changed since they were
+/// loaded, and lets composition update incrementally for every stage using
+/// them. Layers with unsaved in-memory edits are left alone rather than
+/// discarded. Stamps are only committed once the reload succeeded, so a
+/// failed reload is retried next time. Returns the number of layers whose
+/// file changed, -1 when a reload failed, or `kRefreshInsideQuery`.
+int RefreshLayers(const SdfLayerHandleVector &layers) {
+  if (t_readScopeDepth > 0) {
+    return kRefreshInsideQuery;
+  }
+
+  LayerStampRegistry &registry = LayerStampRegistry::GetInstance();
+  const std::vector<std::pair<SdfLayerHandle, double>> changed =
+      registry.Changed(layers);
+  if (changed.empty()) {
+    return 0;
+  }
+
+  std::set<SdfLayerHandle> changedLayers;
+  for (const auto &entry : changed) {
+    changedLayers.insert(entry.first);
+  }
+  {
+    std::unique_lock<std::shared_mutex> reloadLock(g_layerReloadMutex);
+    try {
+      // Without `force`, Sdf skips layers whose contents already match the
+      // file, such as ones only this registry had not seen load.
+      if (!SdfLayer::ReloadLayers(changedLayers, /* force */ false)) {
+        return -1;
+      }
+    } catch (...) {
+      return -1;
+    }
+  }
+  registry.Commit(changed);
+  return static_cast<int>(changed.size());
+}
+
+UsdStage::InitialLoadSet ToInitialLoadSet(USDInteropLoadSet loadSet) {
+  return loadSet == USDINTEROP_LOAD_NONE ? UsdStage::LoadNone
+                                         : UsdStage::LoadAll;
+}
+
+struct StageCacheKey {
+  std::string path;
+  UsdStage::InitialLoadSet loadSet;
+  // Canonical population mask paths; empty for a fully populated stage.
+  std::string mask;
+
+  bool operator==(const StageCacheKey &other) const {
+    return loadSet == other.loadSet && path == other.path &&
+           mask == other.mask;
+  }
+};
+
+struct StageCacheKeyHash {
+  size_t operator()(const StageCacheKey &key) const {
+    const std::hash<std::string> hasher;
+    return hasher(key.path) ^ (hasher(key.mask) << 1) ^
+           (static_cast<size_t>(key.loadSet) << 2);
+  }
+};
+
+std::string CanonicalMaskString(const UsdStagePopulationMask &mask) {
+  std::string result;
+  for (const SdfPath &path : mask.GetPaths()) {
+    if (!result.empty()) {
+      result += ',';
+    }
+    result += path.GetString();
+  }
+  return result;
+}
+
+UsdStageRefPtr OpenStage(const StageCacheKey &key,
+                         const UsdStagePopulationMask &mask) {
+  try {
+    if (key.mask.empty()) {
+      return UsdStage::Open(key.path, key.loadSet);
+    }
+    return UsdStage::OpenMasked(key.path, mask, key.loadSet);
+  } catch (...) {
+    return UsdStageRefPtr();
+  }
+}
+
+/// Bounded LRU over a `UsdStageCache`, keyed by path, load set and population
+/// mask. A cache hit re-stats the stage's layers and reloads the ones whose
+/// file changed, so composition only redoes what the edit touched. Handles
+/// keep their stage alive after eviction, so the capacity only bounds what
+/// the cache itself pins.
+class StageLRUCache {
+ public:
+  static StageLRUCache &GetInstance() {
+    static StageLRUCache instance;
+    return instance;
+  }
+
+  std::shared_ptr<StageState> Acquire(const StageCacheKey &key,
+                                      const UsdStagePopulationMask &mask) {
+    if (std::shared_ptr<StageState> cached = _Find(key)) {
+      // A failed reload leaves the stage as it was and is retried on the
+      // next open; reloading from inside a query is not possible, so such
+      // opens return the stage as last synchronized.
+      RefreshLayers(cached->stage->GetUsedLayers());
+      return cached;
+    }
+
+    // Layers already in memory may predate the file on disk; only the ones
+    // this open loads are known to be current.
+    const SdfLayerHandleSet preexisting = SdfLayer::GetLoadedLayers();
+
+    // Compose outside the lock so unrelated stages can open concurrently.
+    UsdStageRefPtr stage = OpenStage(key, mask);
+    if (!stage) {
+      return nullptr;
+    }
+    const SdfLayerHandleVector usedLayers = stage->GetUsedLayers();
+    LayerStampRegistry::GetInstance().RecordOpened(usedLayers, preexisting);
+    RefreshLayers(usedLayers);
+    auto state = std::make_shared<StageState>(stage);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_capacity == 0) {
+      return state;
+    }
+    if (std::shared_ptr<StageState> cached = _FindLocked(key)) {
+      // Another thread composed the same stage first; share its copy.
+      return cached;
+    }
+
+    _lru.push_front(key);
+    _entries.emplace(key, Entry{state, _stages.Insert(stage), _lru.begin()});
+    _EvictLocked();
+    return state;
+  }
+
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = capacity;
+    _EvictLocked();
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _stages.Clear();
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<StageState> state;
+    UsdStageCache::Id id;
+    std::list<StageCacheKey>::iterator lruPosition;
+  };
+
+  using EntryMap =
+      std::unordered_map<StageCacheKey, Entry, StageCacheKeyHash>;
+
+  std::shared_ptr<StageState> _Find(const StageCacheKey &key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_capacity == 0) {
+      return nullptr;
+    }
+    if (std::shared_ptr<StageState> cached = _FindLocked(key)) {
+      return cached;
+    }
+    if (!key.mask.empty()) {
+      // A fully populated stage already answers any masked request.
+      return _FindLocked(StageCacheKey{key.path, key.loadSet, std::string()});
+    }
+    return nullptr;
+  }
+
+  /// Returns the cached state for `key` and marks it most recently used.
+  std::shared_ptr<StageState> _FindLocked(const StageCacheKey &key) {
+    auto found = _entries.find(key);
+    if (found == _entries.end()) {
+      return nullptr;
+    }
+    _lru.splice(_lru.begin(), _lru, found->second.lruPosition);
+    return found->second.state;
+  }
+
+  void _EraseLocked(EntryMap::iterator entry) {
+    _stages.Erase(entry->second.id);
+    _lru.erase(entry->second.lruPosition);
+    _entries.erase(entry);
+  }
+
+  void _EvictLocked() {
+    while (_entries.size() > _capacity && !_lru.empty()) {
+      auto victim = _entries.find(_lru.back());
+      if (victim == _entries.end()) {
+        _lru.pop_back();
+        continue;
+      }
+      _EraseLocked(victim);
+    }
+  }
+
+  std::mutex _mutex;
+  UsdStageCache _stages;
+  std::list<StageCacheKey> _lru;
+  EntryMap _entries;
+  size_t _capacity = kDefaultStageCacheCapacity;
+};
+} // namespace
+
+struct usdinterop_stage_s {
+  std::atomic<int> refCount{1};
+  std::shared_ptr<StageState> state;
+};
+
+namespace {
+usdinterop_stage_t *MakeStageHandle(const StageCacheKey &key,
+                                    const UsdStagePopulationMask &mask) {
+  std::shared_ptr<StageState> state =
+      StageLRUCache::GetInstance().Acquire(key, mask);
+  if (!state) {
+    return nullptr;
+  }
+
+  auto *handle = new usdinterop_stage_t();
+  handle->state = std::move(state);
+  return handle;
+}
+} // namespace
+
+namespace USDInteropInternal {
+UsdStageRefPtr StageFromHandle(const usdinterop_stage_t *stage) {
+  return stage ? stage->state->stage : UsdStageRefPtr();
+}
+
+StageReadScope::StageReadScope(const usdinterop_stage_t *stage)
+    : _stage(StageFromHandle(stage)) {
+  if (t_readScopeDepth++ == 0) {
+    _lock = std::shared_lock<std::shared_mutex>(g_layerReloadMutex);
+  }
+}
+
+StageReadScope::~StageReadScope() {
+  --t_readScopeDepth;
+}
+} // namespace USDInteropInternal
+
+usdinterop_stage_t *usdinterop_stage_open(const char *path,
+                                          USDInteropLoadSet load_set) {
+  if (!path || path[0] == '\0') {
+    return nullptr;
+  }
+
+  const StageCacheKey key{std::string(path), ToInitialLoadSet(load_set),
+                          std::string()};
+  return MakeStageHandle(key, UsdStagePopulationMask());
+}
+
+usdinterop_stage_t *usdinterop_stage_open_masked(const char *path,
+                                                 USDInteropLoadSet load_set,
+                                                 const char *const *prim_paths,
+                                                 size_t prim_path_count) {
+  if (!path || path[0] == '\0') {
+    return nullptr;
+  }
+  if (!prim_paths || prim_path_count == 0) {
+    return usdinterop_stage_open(path, load_set);
+  }
+
+  UsdStagePopulationMask mask;
+  for (size_t index = 0; index < prim_path_count; ++index) {
+    const char *primPath = prim_paths[index];
+    if (!primPath || primPath[0] == '\0') {
+      continue;
+    }
+    const SdfPath maskPath(primPath);
+    if (maskPath.IsAbsoluteRootPath()) {
+      // The pseudo-root covers everything; compose the full stage.
+      return usdinterop_stage_open(path, load_set);
+    }
+    if (!maskPath.IsAbsolutePath() || !maskPath.IsPrimPath()) {
+      return nullptr;
+    }
+    mask.Add(maskPath);
+  }
+  if (mask.IsEmpty()) {
+    return usdinterop_stage_open(path, load_set);
+  }
+
+  const StageCacheKey key{std::string(path), ToInitialLoadSet(load_set),
+                          CanonicalMaskString(mask)};
+  return MakeStageHandle(key, mask);
+}
+
+usdinterop_stage_t *usdinterop_stage_retain(usdinterop_stage_t *stage) {
+  if (stage) {
+    stage->refCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  return stage;
+}
+
+void usdinterop_stage_release(usdinterop_stage_t *stage) {
+  if (!stage) {
+    return;
+  }
+  if (stage->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete stage;
+  }
+}
+
+int usdinterop_stage_refresh(usdinterop_stage_t *stage) {
+  if (!stage) {
+    return -1;
+  }
+  return RefreshLayers(stage->state->stage->GetUsedLayers());
+}
+
+void usdinterop_stage_cache_set_capacity(size_t capacity) {
+  StageLRUCache::GetInstance().SetCapacity(capacity);
+}
+
+void usdinterop_stage_cache_clear(void) {
+  StageLRUCache::GetInstance().Clear();
+}
@@ -0,0 +1,333 @@
+#include "USDInteropInternal.hpp"
+
+#include "pxr/base/tf/token.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/base/work/threadLimits.h"
+#include "pxr/usd/ar/asset.h"
+#include "pxr/usd/ar/resolvedPath.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/primvarsAPI.h"
+#include "pxr/usd/usdShade/material.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using USDInteropInternal::StageReadScope;
+
+namespace {
+// The traversal is split into at least this many subtrees per worker, so
+// unevenly sized subtrees still balance, but no deeper than the cap.
+constexpr size_t kSubtreesPerWorker = 4;
+constexpr size_t kMaxSplitDepth = 8;
+
+/// Per-task totals merged into the final result.
+struct StatisticsTotals {
+  uint64_t primCount = 0;
+  uint64_t meshCount = 0;
+  uint64_t meshPointCount = 0;
+  uint64_t meshFaceCount = 0;
+  uint64_t meshFaceVertexCount = 0;
+  uint64_t meshPrimvarCount = 0;
+  uint64_t materialCount = 0;
+  uint64_t instanceCount = 0;
+  std::unordered_map<TfToken, uint64_t, TfToken::HashFunctor> typeCounts;
+};
+
+/// Paths listed by one traversal item, in traversal order.
+struct ItemPaths {
+  std::vector<SdfPath> cameras;
+  std::vector<SdfPath> animations;
+};
+
+/// A prim to analyse, with its descendants when `subtree` is set.
+struct TraversalItem {
+  UsdPrim prim;
+  bool subtree;
+};
+
+/// Splits the hierarchy below `root` into items in traversal order: prims
+/// above the split depth stand alone and each prim at that depth carries its
+/// subtree. The depth grows until there are `target` subtrees, the tree runs
+/// out, or the cap is reached; only the levels above it are walked serially.
+void SplitTraversal(const UsdPrim &root, size_t target,
+                    std::vector<TraversalItem> &items) {
+  const size_t rootDepth = root.GetPath().GetPathElementCount();
+  std::vector<TraversalItem> split;
+  for (size_t depth = 1;; ++depth) {
+    split.clear();
+    size_t subtrees = 0;
+    UsdPrimRange range(root);
+    for (auto it = range.begin(); it != range.end(); ++it) {
+      if (*it == root) {
+        continue;
+      }
+      if ((*it).GetPath().GetPathElementCount() - rootDepth == depth) {
+        split.push_back(TraversalItem{*it, true});
+        ++subtrees;
+        it.PruneChildren();
+      } else {
+        split.push_back(TraversalItem{*it, false});
+      }
+    }
+    if (subtrees == 0 || subtrees >= target || depth == kMaxSplitDepth) {
+      break;
+    }
+  }
+  items.insert(items.end(), split.begin(), split.end());
+}
+
+bool IsAnimationType(const TfToken &typeName) {
+  static const TfToken skelAnimation("SkelAnimation");
+  static const TfToken animation("Animation");
+  static const TfToken realityKitTimeline("RealityKitTimeline");
+  return typeName == skelAnimation || typeName == animation ||
+         typeName == realityKitTimeline;
+}
+
+void AnalyzePrim(const UsdPrim &prim, uint32_t options,
+                 StatisticsTotals &totals, ItemPaths &paths) {
+  static const TfToken camera("Camera");
+  const TfToken typeName = prim.GetTypeName();
+  totals.primCount += 1;
+  totals.typeCounts[typeName] += 1;
+  if (prim.IsInstance()) {
+    totals.instanceCount += 1;
+  }
+  // Prototype paths are not addressable by users, so only prims on the
+  // stage's own hierarchy are listed. Cameras match the type name exactly,
+  // as stage metadata always has.
+  if (!prim.IsInPrototype()) {
+    if (IsAnimationType(typeName)) {
+      paths.animations.push_back(prim.GetPath());
+    } else if (typeName == camera) {
+      paths.cameras.push_back(prim.GetPath());
+    }
+  }
+  if (!(options & USDINTEROP_STATISTICS_MESHES)) {
+    return;
+  }
+  if (prim.IsA<UsdShadeMaterial>()) {
+    totals.materialCount += 1;
+  } else if (prim.IsA<UsdGeomMesh>()) {
+    const UsdGeomMesh mesh(prim);
+    totals.meshCount += 1;
+    VtVec3fArray points;
+    if (mesh.GetPointsAttr().Get(&points)) {
+      totals.meshPointCount += points.size();
+    }
+    VtIntArray faceVertexCounts;
+    if (mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts)) {
+      totals.meshFaceCount += faceVertexCounts.size();
+      for (const int count : faceVertexCounts) {
+        totals.meshFaceVertexCount += count > 0 ? count : 0;
+      }
+    }
+    totals.meshPrimvarCount +=
+        UsdGeomPrimvarsAPI(prim).GetAuthoredPrimvars().size();
+  }
+}
+
+uint64_t EstimateLayerBytes(const SdfLayerHandle &layer) {
+  if (!layer || layer->IsAnonymous()) {
+    return 0;
+  }
+  const std::string &realPath = layer->GetRealPath();
+  if (realPath.empty()) {
+    return 0;
+  }
+  // Goes through Ar so layers inside packages report their packaged size.
+  const std::shared_ptr<ArAsset> asset =
+      ArGetResolver().OpenAsset(ArResolvedPath(realPath));
+  return asset ? static_cast<uint64_t>(asset->GetSize()) : 0;
+}
+
+size_t CopyPathList(const std::vector<SdfPath> &paths, const char **pointers,
+                    char *&text) {
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const std::string &path = paths[i].GetString();
+    std::memcpy(text, path.c_str(), path.size() + 1);
+    pointers[i] = text;
+    text += path.size() + 1;
+  }
+  return paths.size();
+}
+
+USDInteropStageStatistics *ComputeStageStatistics(const UsdStage &stage,
+                                                  uint32_t options) {
+  // Only the top levels are walked serially; subtrees below the split are
+  // traversed and analysed in parallel.
+  const size_t target = WorkGetConcurrencyLimit() * kSubtreesPerWorker;
+  std::vector<TraversalItem> items;
+  SplitTraversal(stage.GetPseudoRoot(), target, items);
+  std::vector<UsdPrim> prototypes;
+  if (options & USDINTEROP_STATISTICS_PROTOTYPES) {
+    prototypes = stage.GetPrototypes();
+    for (const UsdPrim &prototype : prototypes) {
+      SplitTraversal(prototype, target, items);
+    }
+  }
+
+  StatisticsTotals totals;
+  std::mutex totalsMutex;
+  std::vector<ItemPaths> itemPaths(items.size());
+  WorkParallelForN(items.size(), [&](size_t begin, size_t end) {
+    StatisticsTotals local;
+    for (size_t i = begin; i < end; ++i) {
+      if (!items[i].subtree) {
+        AnalyzePrim(items[i].prim, options, local, itemPaths[i]);
+        continue;
+      }
+      for (const UsdPrim &prim : UsdPrimRange(items[i].prim)) {
+        AnalyzePrim(prim, options, local, itemPaths[i]);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(totalsMutex);
+    totals.primCount += local.primCount;
+    totals.meshCount += local.meshCount;
+    totals.meshPointCount += local.meshPointCount;
+    totals.meshFaceCount += local.meshFaceCount;
+    totals.meshFaceVertexCount += local.meshFaceVertexCount;
+    totals.meshPrimvarCount += local.meshPrimvarCount;
+    totals.materialCount += local.materialCount;
+    totals.instanceCount += local.instanceCount;
+    for (const auto &entry : local.typeCounts) {
+      totals.typeCounts[entry.first] += entry.second;
+    }
+  });
+  // Items are in traversal order, so concatenating them keeps paths in that
+  // order regardless of task scheduling.
+  std::vector<SdfPath> cameras;
+  std::vector<SdfPath> animations;
+  for (const ItemPaths &paths : itemPaths) {
+    cameras.insert(cameras.end(), paths.cameras.begin(), paths.cameras.end());
+    animations.insert(animations.end(), paths.animations.begin(),
+                      paths.animations.end());
+  }
+
+  std::vector<std::pair<TfToken, uint64_t>> typeCounts(
+      totals.typeCounts.begin(), totals.typeCounts.end());
+  std::sort(typeCounts.begin(), typeCounts.end(),
+            [](const auto &lhs, const auto &rhs) {
+              return lhs.second != rhs.second
+                         ? lhs.second > rhs.second
+                         : lhs.first.GetString() < rhs.first.GetString();
+            });
+
+  SdfLayerHandleVector layers;
+  if (options & USDINTEROP_STATISTICS_LAYERS) {
+    layers = stage.GetUsedLayers();
+  }
+  std::vector<uint64_t> layerBytes(layers.size(), 0);
+  WorkParallelForN(layers.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      layerBytes[i] = EstimateLayerBytes(layers[i]);
+    }
+  });
+
+  size_t textSize = 0;
+  for (const auto &entry : typeCounts) {
+    textSize += entry.first.GetString().size() + 1;
+  }
+  for (const SdfPath &path : cameras) {
+    textSize += path.GetString().size() + 1;
+  }
+  for (const SdfPath &path : animations) {
+    textSize += path.GetString().size() + 1;
+  }
+
+  const size_t blockSize =
+      sizeof(USDInteropStageStatistics) +
+      typeCounts.size() * sizeof(USDInteropPrimTypeCount) +
+      (cameras.size() + animations.size()) * sizeof(char *) +
+      textSize;
+  char *block = static_cast<char *>(std::malloc(blockSize));
+  if (!block) {
+    return nullptr;
+  }
+
+  auto *result = reinterpret_cast<USDInteropStageStatistics *>(block);
+  std::memset(result, 0, sizeof(USDInteropStageStatistics));
+  result->primCount = totals.primCount;
+  result->meshCount = totals.meshCount;
+  result->meshPointCount = totals.meshPointCount;
+  result->meshFaceCount = totals.meshFaceCount;
+  result->meshFaceVertexCount = totals.meshFaceVertexCount;
+  result->meshPrimvarCount = totals.meshPrimvarCount;
+  result->materialCount = totals.materialCount;
+  result->instanceCount = totals.instanceCount;
+  result->prototypeCount = prototypes.size();
+  result->layerCount = layers.size();
+  for (const uint64_t bytes : layerBytes) {
+    result->layerByteEstimate += bytes;
+  }
+
+  result->typeCounts = reinterpret_cast<USDInteropPrimTypeCount *>(
+      block + sizeof(USDInteropStageStatistics));
+  result->cameraPaths =
+      reinterpret_cast<const char **>(result->typeCounts + typeCounts.size());
+  result->animationPaths = result->cameraPaths + cameras.size();
+  char *text =
+      reinterpret_cast<char *>(result->animationPaths + animations.size());
+
+  for (size_t i = 0; i < typeCounts.size(); ++i) {
+    const std::string &typeName = typeCounts[i].first.GetString();
+    std::memcpy(text, typeName.c_str(), typeName.size() + 1);
+    result->typeCounts[i].typeName = text;
+    result->typeCounts[i].count = typeCounts[i].second;
+    text += typeName.size() + 1;
+  }
+  result->typeCountCount = typeCounts.size();
+  result->cameraCount = CopyPathList(cameras, result->cameraPaths, text);
+  result->animationCount =
+      CopyPathList(animations, result->animationPaths, text);
+  return result;
+}
+} // namespace
+
+USDInteropStageStatistics *
+usdinterop_stage_statistics(const usdinterop_stage_t *stage) {
+  return usdinterop_stage_statistics_with_options(stage,
+                                                  USDINTEROP_STATISTICS_ALL);
+}
+
+USDInteropStageStatistics *
+usdinterop_stage_statistics_with_options(const usdinterop_stage_t *stage,
+                                         uint32_t options) {
+  try {
+    StageReadScope scope(stage);
+    const UsdStageRefPtr &usdStage = scope.Get();
+    if (!usdStage) {
+      return nullptr;
+    }
+    return ComputeStageStatistics(*usdStage, options);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void usdinterop_free_stage_statistics(USDInteropStageStatistics *statistics) {
+  // The lists and strings share the result's allocation.
+  std::free(statistics);
+}
+
+namespace USDInterop {
+USDInteropStageStatistics *GetStageStatistics(const USD::UsdStage &stage,
+                                              uint32_t options) {
+  try {
+    return ComputeStageStatistics(stage, options);
+  } catch (...) {
+    return nullptr;
+  }
+}
+} // namespace USDInterop
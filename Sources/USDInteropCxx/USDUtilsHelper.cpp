@@ -1,141 +1,603 @@
 
 #include "USDUtilsHelper.hpp"
+#include "USDInteropDependencyCache.hpp"
+#include "USDZArchive.hpp"
 #include "pxr/base/tf/token.h"
 #include "pxr/base/tf/diagnosticMgr.h"
+#include "pxr/base/tf/errorMark.h"
+#include "pxr/base/tf/pathUtils.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/base/work/threadLimits.h"
+#include "pxr/usd/ar/asset.h"
+#include "pxr/usd/ar/packageUtils.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/schema.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
 #include <exception>
-#include <regex>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
-// Thread-local cache for unresolved paths
+#include <sys/stat.h>
+
+// Legacy thread-local results read back by `GetUnresolvedPath` and the
+// `GetPackaging*` accessors. The report-returning entry points do not use them.
 static thread_local std::vector<std::string> g_unresolvedCache;
-struct PackagingDiagnosticCacheItem {
-  int severity;
-  std::string message;
-};
-static thread_local std::vector<PackagingDiagnosticCacheItem>
-    g_packagingDiagnosticCache;
-static thread_local std::vector<std::string> g_packagingFailedAssetPathCache;
+static thread_local PackagingDiagnosticsCxx g_packagingDiagnostics;
 
 namespace {
-void CacheFailedAssetPath(const std::string &path, std::set<std::string> &seenPaths) {
-  if (path.empty()) {
-    return;
+/// Returns the text between `prefix` and the next `terminator`, or an empty
+/// string when `commentary` does not contain `prefix`.
+std::string ExtractDelimitedPath(const std::string &commentary,
+                                 const char *prefix, char terminator) {
+  const size_t prefixStart = commentary.find(prefix);
+  if (prefixStart == std::string::npos) {
+    return std::string();
   }
-  if (seenPaths.insert(path).second) {
-    g_packagingFailedAssetPathCache.push_back(path);
+  const size_t pathStart = prefixStart + std::strlen(prefix);
+  const size_t pathEnd = commentary.find(terminator, pathStart);
+  if (pathEnd == std::string::npos || pathEnd == pathStart) {
+    return std::string();
   }
+  return commentary.substr(pathStart, pathEnd - pathStart);
 }
 
-void CachePackagingDiagnostic(
-    int severity,
-    const std::string &commentary,
-    std::set<std::string> &seenPaths) {
-  g_packagingDiagnosticCache.push_back(
-      PackagingDiagnosticCacheItem{severity, commentary});
+/// Accumulates the diagnostics of one packaging call.
+class PackagingDiagnosticsCollector {
+ public:
+  void AddDiagnostic(int severity, const std::string &message) {
+    const uint32_t offset = AppendText(message);
+    _diagnostics.diagnostics.push_back(PackagingDiagnosticRecordCxx{
+        severity, offset, static_cast<uint32_t>(message.size())});
+  }
 
-  std::smatch match;
-  static const std::regex addFilePattern("Failed to add file '([^']+)'");
-  static const std::regex mapFilePattern("Failed to map '([^']+)'");
-  static const std::regex resolveReferencePattern(
-      "Failed to resolve reference @([^@]+)@");
+  void AddFailedAssetPath(const std::string &path) {
+    if (path.empty()) {
+      return;
+    }
+    if (_failedAssetPaths.insert(path).second) {
+      _diagnostics.failedAssetPathOffsets.push_back(AppendText(path));
+    }
+  }
+
+  /// Records a diagnostic issued by UsdUtils. Its failures only reach us as
+  /// text, so the asset path is recovered from the known message shapes.
+  void AddUsdUtilsDiagnostic(int severity, const std::string &commentary) {
+    AddDiagnostic(severity, commentary);
+    if (commentary.find("Failed ") == std::string::npos) {
+      return;
+    }
 
-  if (std::regex_search(commentary, match, addFilePattern) && match.size() > 1) {
-    CacheFailedAssetPath(match[1].str(), seenPaths);
-    return;
+    std::string path =
+        ExtractDelimitedPath(commentary, "Failed to add file '", '\'');
+    if (path.empty()) {
+      path = ExtractDelimitedPath(commentary, "Failed to map '", '\'');
+    }
+    if (path.empty()) {
+      path = ExtractDelimitedPath(commentary,
+                                  "Failed to resolve reference @", '@');
+    }
+    AddFailedAssetPath(path);
   }
-  if (std::regex_search(commentary, match, mapFilePattern) && match.size() > 1) {
-    CacheFailedAssetPath(match[1].str(), seenPaths);
-    return;
+
+  PackagingDiagnosticsCxx Take() {
+    _failedAssetPaths.clear();
+    return std::move(_diagnostics);
   }
-  if (std::regex_search(commentary, match, resolveReferencePattern) &&
-      match.size() > 1) {
-    CacheFailedAssetPath(match[1].str(), seenPaths);
-    return;
+
+ private:
+  uint32_t AppendText(const std::string &value) {
+    const uint32_t offset = static_cast<uint32_t>(_diagnostics.text.size());
+    _diagnostics.text.append(value);
+    _diagnostics.text.push_back('\0');
+    return offset;
   }
-}
 
+  PackagingDiagnosticsCxx _diagnostics;
+  std::unordered_set<std::string> _failedAssetPaths;
+};
+
+/// Forwards the warnings, status messages and fatal errors issued on the
+/// packaging thread into a collector. Delegates are process-wide and a
+/// diagnostic from another thread cannot name the call it belongs to, so
+/// those are ignored: a report never depends on what else the process is
+/// doing, but warnings UsdUtils issues on Work threads are not captured.
 class PackagingDiagnosticDelegate final : public TfDiagnosticMgr::Delegate {
  public:
-  void IssueError(const TfError &error) override {
-    CachePackagingDiagnostic(2, error.GetCommentary(), _seenPaths);
+  explicit PackagingDiagnosticDelegate(
+      PackagingDiagnosticsCollector &collector)
+      : _collector(collector), _thread(std::this_thread::get_id()) {}
+
+  void IssueError(const TfError &) override {
+    // Errors on the packaging thread, including those Work threads hand
+    // back to it, are read from its TfErrorMark instead.
   }
 
   void IssueFatalError(const TfCallContext &, const std::string &message) override {
-    CachePackagingDiagnostic(3, message, _seenPaths);
+    Add(3, message);
   }
 
   void IssueStatus(const TfStatus &status) override {
-    CachePackagingDiagnostic(0, status.GetCommentary(), _seenPaths);
+    Add(0, status.GetCommentary());
   }
 
   void IssueWarning(const TfWarning &warning) override {
-    CachePackagingDiagnostic(1, warning.GetCommentary(), _seenPaths);
+    Add(1, warning.GetCommentary());
   }
 
  private:
-  std::set<std::string> _seenPaths;
+  void Add(int severity, const std::string &message) {
+    if (std::this_thread::get_id() == _thread) {
+      _collector.AddUsdUtilsDiagnostic(severity, message);
+    }
+  }
+
+  PackagingDiagnosticsCollector &_collector;
+  std::thread::id _thread;
 };
 
-class ScopedPackagingDelegateRegistration {
+/// Collects Tf diagnostics for one packaging call. Errors on the calling
+/// thread, including those a WorkDispatcher transports back from its
+/// workers, are read from a TfErrorMark; other diagnostics on the calling
+/// thread go through `PackagingDiagnosticDelegate`. Call `Finish` once the
+/// work is done.
+class ScopedPackagingDiagnostics {
  public:
-  explicit ScopedPackagingDelegateRegistration(
-      TfDiagnosticMgr::Delegate *delegate)
-      : _delegate(delegate) {
-    TfDiagnosticMgr::GetInstance().AddDelegate(_delegate);
+  explicit ScopedPackagingDiagnostics(
+      PackagingDiagnosticsCollector &collector)
+      : _collector(collector), _delegate(collector) {
+    TfDiagnosticMgr::GetInstance().AddDelegate(&_delegate);
+  }
+
+  ~ScopedPackagingDiagnostics() {
+    // Removed before `_mark` is destroyed, which may report the errors it
+    // holds to delegates.
+    TfDiagnosticMgr::GetInstance().RemoveDelegate(&_delegate);
   }
 
-  ~ScopedPackagingDelegateRegistration() {
-    if (_delegate) {
-      TfDiagnosticMgr::GetInstance().RemoveDelegate(_delegate);
+  ScopedPackagingDiagnostics(const ScopedPackagingDiagnostics &) = delete;
+  ScopedPackagingDiagnostics &
+  operator=(const ScopedPackagingDiagnostics &) = delete;
+
+  /// Copies the errors raised since construction. They are left in place so
+  /// the caller's own error handling still sees them.
+  void Finish() {
+    for (auto it = _mark.GetBegin(); it != _mark.GetEnd(); ++it) {
+      _collector.AddUsdUtilsDiagnostic(2, it->GetCommentary());
     }
   }
 
  private:
-  TfDiagnosticMgr::Delegate *_delegate;
+  PackagingDiagnosticsCollector &_collector;
+  TfErrorMark _mark;
+  PackagingDiagnosticDelegate _delegate;
 };
 
-void ClearPackagingCaches() {
-  g_packagingDiagnosticCache.clear();
-  g_packagingFailedAssetPathCache.clear();
+UsdzPackagingReportCxx MakePackagingReport(
+    bool success, PackagingDiagnosticsCollector &collector) {
+  UsdzPackagingReportCxx report;
+  report.diagnostics = collector.Take();
+  report.reusedEntries = 0;
+  report.reusedBytes = 0;
+
+  UsdzPackagingResultCxx &result = report.summary;
+  result.success = success;
+  result.diagnosticCount =
+      static_cast<int>(report.diagnostics.diagnostics.size());
+  result.failedAssetCount =
+      static_cast<int>(report.diagnostics.failedAssetPathOffsets.size());
+  result.warningCount = 0;
+  result.errorCount = 0;
+  for (const auto &diagnostic : report.diagnostics.diagnostics) {
+    if (diagnostic.severity == 1) {
+      result.warningCount += 1;
+    } else if (diagnostic.severity >= 2) {
+      result.errorCount += 1;
+    }
+  }
+  return report;
 }
-} // namespace
 
-DependencyCheckResultCxx CheckDependenciesSimple(const std::string &assetPath) {
-  DependencyCheckResultCxx result;
-  result.success = false;
-  result.unresolvedCount = 0;
+/// Mirrors a report into the thread-local state behind the legacy accessors.
+UsdzPackagingResultCxx StoreLegacyPackagingReport(
+    UsdzPackagingReportCxx report) {
+  g_packagingDiagnostics = std::move(report.diagnostics);
+  return report.summary;
+}
 
-  // Clear previous cache
-  g_unresolvedCache.clear();
+// Upper bound on asset bytes read ahead of the writer. A single larger asset
+// is still read, on its own.
+constexpr size_t kPackagingReadAheadBudget = size_t(256) << 20;
 
-  try {
-    SdfAssetPath sdfAssetPath(assetPath);
-    std::vector<SdfLayerRefPtr> layers;
-    std::vector<std::string> assets;
-    std::vector<std::string> unresolved;
+struct PackageEntry {
+  std::string name;       // path inside the archive
+  std::string sourcePath; // resolved path on disk
+  size_t size;
+  uint32_t dosDateTime;
+  USDInteropInternal::UsdzSourceStamp sourceStamp;
+  // False when the file was modified within the current second, where a
+  // filesystem with coarse timestamps could hide a further edit.
+  bool sourceStampSettled;
+};
 
-    // Call with default std::function()
-    bool usdResult = UsdUtilsComputeAllDependencies(
-        sdfAssetPath, &layers, &assets, &unresolved,
-        std::function<UsdUtilsProcessingFunc>());
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+bool StatPackageEntry(const std::string &sourcePath,
+                      const std::string &rootDirectory,
+                      PackageEntry &entry) {
+  struct stat info = {};
+  if (sourcePath.compare(0, rootDirectory.size(), rootDirectory) != 0 ||
+      ::stat(sourcePath.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+  entry.name = sourcePath.substr(rootDirectory.size());
+  entry.sourcePath = sourcePath;
+  entry.size = static_cast<size_t>(info.st_size);
+  entry.dosDateTime = USDInteropInternal::DosDateTime(info.st_mtime);
+#if defined(__APPLE__)
+  const struct timespec &modified = info.st_mtimespec;
+#else
+  const struct timespec &modified = info.st_mtim;
+#endif
+  entry.sourceStamp.size = static_cast<uint64_t>(info.st_size);
+  entry.sourceStamp.mtimeNanoseconds =
+      static_cast<int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+  entry.sourceStamp.inode = static_cast<uint64_t>(info.st_ino);
+  entry.sourceStamp.device = static_cast<uint64_t>(info.st_dev);
+  entry.sourceStampSettled = modified.tv_sec < std::time(nullptr);
+  return true;
+}
+
+/// Lists the files to package, root layer first, named by their path relative
+/// to the root layer's directory. Returns false when the package can only be
+/// built by rewriting asset paths, which `UsdUtilsCreateNewUsdzPackage` does.
+bool CollectPackageEntries(const std::string &assetPath,
+                           std::vector<PackageEntry> &entries) {
+  bool needsRewrite = false;
+  const auto inspectDependency = [&needsRewrite](
+                                     const SdfLayerHandle &,
+                                     const UsdUtilsDependencyInfo &info) {
+    const std::string &authoredPath = info.GetAssetPath();
+    if (!authoredPath.empty() &&
+        (!TfIsRelativePath(authoredPath) ||
+         ArIsPackageRelativePath(authoredPath))) {
+      needsRewrite = true;
+    }
+    return info;
+  };
+
+  std::vector<SdfLayerRefPtr> layers;
+  std::vector<std::string> assets;
+  std::vector<std::string> unresolved;
+  if (!UsdUtilsComputeAllDependencies(SdfAssetPath(assetPath), &layers,
+                                      &assets, &unresolved,
+                                      inspectDependency) ||
+      needsRewrite || !unresolved.empty()) {
+    return false;
+  }
 
-    // Cache unresolved paths
-    g_unresolvedCache = unresolved;
+  const std::string rootPath = ArGetResolver().Resolve(assetPath);
+  if (rootPath.empty() || ArIsPackageRelativePath(rootPath)) {
+    return false;
+  }
+  const std::string rootDirectory = TfGetPathName(rootPath);
 
-    result.success = usdResult;
-    result.unresolvedCount = static_cast<int>(unresolved.size());
+  PackageEntry rootEntry;
+  if (!StatPackageEntry(rootPath, rootDirectory, rootEntry)) {
+    return false;
+  }
+  entries.push_back(rootEntry);
+
+  std::set<std::string> seenPaths{rootPath};
+  std::vector<std::string> sourcePaths;
+  for (const SdfLayerRefPtr &layer : layers) {
+    if (!layer || layer->IsAnonymous() || layer->IsDirty()) {
+      return false;
+    }
+    sourcePaths.push_back(layer->GetRealPath());
+  }
+  sourcePaths.insert(sourcePaths.end(), assets.begin(), assets.end());
+
+  for (const std::string &sourcePath : sourcePaths) {
+    if (!seenPaths.insert(sourcePath).second) {
+      continue;
+    }
+    PackageEntry entry;
+    if (sourcePath.empty() || ArIsPackageRelativePath(sourcePath) ||
+        !StatPackageEntry(sourcePath, rootDirectory, entry)) {
+      return false;
+    }
+    entries.push_back(std::move(entry));
+  }
+  return true;
+}
+
+struct LoadedPackageEntry {
+  std::shared_ptr<const char> buffer;
+  // Bytes to write: `buffer`, or an entry in the previous package.
+  const char *data = nullptr;
+  uint32_t crc = 0;
+  bool ready = false;
+  bool ok = false;
+  bool reused = false;
+};
+
+/// Loads one entry, preferring the copy in `previous`. When the previous
+/// entry recorded the same source stamp (size, nanosecond mtime, inode and
+/// device) the source is not opened at all. Otherwise the source is read and
+/// the previous bytes are reused only if its size and CRC match, since DOS
+/// timestamps are local time with 2-second resolution.
+LoadedPackageEntry LoadPackageEntry(
+    ArResolver &resolver, const PackageEntry &entry,
+    const USDInteropInternal::UsdzArchiveReader *previous) {
+  LoadedPackageEntry result;
+  const USDInteropInternal::UsdzArchiveReader::Entry *reusable =
+      previous ? previous->Find(entry.name) : nullptr;
+  if (reusable && reusable->size != entry.size) {
+    reusable = nullptr;
+  }
+  if (reusable && reusable->hasSourceStamp && entry.sourceStampSettled &&
+      reusable->sourceStamp == entry.sourceStamp) {
+    result.data = reusable->data;
+    result.crc = reusable->crc;
+    result.ok = true;
+    result.reused = true;
     return result;
-  } catch (const std::exception &e) {
-    g_unresolvedCache.clear();
-    g_unresolvedCache.push_back(std::string("C++ exception: ") + e.what());
-    result.unresolvedCount = 1;
+  }
+
+  std::shared_ptr<ArAsset> asset =
+      resolver.OpenAsset(ArResolvedPath(entry.sourcePath));
+  if (!asset || asset->GetSize() != entry.size) {
     return result;
-  } catch (...) {
-    g_unresolvedCache.clear();
-    g_unresolvedCache.push_back("Unknown C++ exception");
-    result.unresolvedCount = 1;
+  }
+  result.buffer = asset->GetBuffer();
+  result.ok = result.buffer || entry.size == 0;
+  if (!result.ok) {
     return result;
   }
+  result.data = result.buffer.get();
+  result.crc = USDInteropInternal::Crc32(0, result.data, entry.size);
+  if (reusable && reusable->crc == result.crc) {
+    result.buffer.reset();
+    result.data = reusable->data;
+    result.reused = true;
+  }
+  return result;
+}
+
+/// Reads entries on a pool of threads, in order and within the read-ahead
+/// budget, while the calling thread writes them. Reservations are granted in
+/// entry order, so the entry the writer needs next can always be read.
+bool WritePackageEntries(const std::vector<PackageEntry> &entries,
+                         const USDInteropInternal::UsdzArchiveReader *previous,
+                         const std::string &outputPath,
+                         UsdzPackagingProgressCxx &progress,
+                         UsdzPackagingProgressCallback callback,
+                         void *context,
+                         PackagingDiagnosticsCollector &diagnostics) {
+  USDInteropInternal::UsdzArchiveWriter writer;
+  if (!writer.Open(outputPath)) {
+    diagnostics.AddDiagnostic(
+        2, "Failed to open '" + outputPath + "' for writing");
+    return false;
+  }
+
+  std::vector<LoadedPackageEntry> loaded(entries.size());
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::atomic<size_t> nextToRead{0};
+  size_t nextToReserve = 0;
+  size_t bytesInFlight = 0;
+  bool aborted = false;
+  std::atomic<int64_t> readNanoseconds{0};
+
+  const auto readEntries = [&]() {
+    ArResolver &resolver = ArGetResolver();
+    for (;;) {
+      const size_t index = nextToRead.fetch_add(1);
+      if (index >= entries.size()) {
+        return;
+      }
+      const PackageEntry &entry = entries[index];
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() {
+          return aborted ||
+                 (nextToReserve == index &&
+                  (bytesInFlight == 0 ||
+                   bytesInFlight + entry.size <= kPackagingReadAheadBudget));
+        });
+        if (aborted) {
+          return;
+        }
+        bytesInFlight += entry.size;
+        ++nextToReserve;
+      }
+      changed.notify_all();
+
+      const auto start = std::chrono::steady_clock::now();
+      LoadedPackageEntry result;
+      try {
+        result = LoadPackageEntry(resolver, entry, previous);
+      } catch (...) {
+        result = LoadedPackageEntry();
+      }
+      result.ready = true;
+      readNanoseconds.fetch_add(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        loaded[index] = std::move(result);
+      }
+      changed.notify_all();
+    }
+  };
+
+  // Joins the readers on every exit from this function. Readers are aborted
+  // first, so an exception thrown by the writer loop neither destroys a
+  // joinable thread nor waits on reads nobody will consume.
+  struct ReaderThreads {
+    std::mutex &mutex;
+    std::condition_variable &changed;
+    bool &aborted;
+    std::vector<std::thread> threads;
+
+    void Join(bool abort) {
+      if (abort) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          aborted = true;
+        }
+        changed.notify_all();
+      }
+      for (std::thread &thread : threads) {
+        if (thread.joinable()) {
+          thread.join();
+        }
+      }
+    }
+
+    ~ReaderThreads() { Join(true); }
+  } readers{mutex, changed, aborted, {}};
+
+  const size_t threadCount = std::max<size_t>(
+      1, std::min<size_t>(WorkGetConcurrencyLimit(), entries.size()));
+  readers.threads.reserve(threadCount);
+  for (size_t index = 0; index < threadCount; ++index) {
+    readers.threads.emplace_back(readEntries);
+  }
+
+  const auto writeStart = std::chrono::steady_clock::now();
+  bool success = true;
+  for (size_t index = 0; index < entries.size(); ++index) {
+    const PackageEntry &entry = entries[index];
+    LoadedPackageEntry current;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&]() { return loaded[index].ready; });
+      current = std::move(loaded[index]);
+    }
+
+    const bool added =
+        current.ok &&
+        writer.AddEntry(entry.name, current.data, entry.size, current.crc,
+                        entry.dosDateTime,
+                        entry.sourceStampSettled ? &entry.sourceStamp
+                                                 : nullptr);
+    current.buffer.reset();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      bytesInFlight -= entry.size;
+      if (!added) {
+        aborted = true;
+      }
+    }
+    changed.notify_all();
+
+    if (!added) {
+      diagnostics.AddFailedAssetPath(entry.sourcePath);
+      diagnostics.AddDiagnostic(
+          2, "Failed to add file '" + entry.sourcePath + "' to package");
+      success = false;
+      break;
+    }
+
+    progress.completedEntries += 1;
+    progress.completedBytes += static_cast<int64_t>(entry.size);
+    if (current.reused) {
+      progress.reusedEntries += 1;
+      progress.reusedBytes += static_cast<int64_t>(entry.size);
+    }
+    progress.readSeconds = readNanoseconds.load() / 1e9;
+    progress.writeSeconds = SecondsSince(writeStart);
+    if (callback) {
+      callback(progress, context);
+    }
+  }
+
+  readers.Join(false);
+  progress.readSeconds = readNanoseconds.load() / 1e9;
+
+  if (!success) {
+    writer.Discard();
+    return false;
+  }
+  if (!writer.Close()) {
+    diagnostics.AddDiagnostic(2, "Failed to finalize '" + outputPath + "'");
+    return false;
+  }
+  progress.writeSeconds = SecondsSince(writeStart);
+  return true;
+}
+} // namespace
+
+DependencyCheckReportCxx
+CheckDependenciesReport(const std::string &assetPath) {
+  DependencyCheckReportCxx report;
+  report.success = false;
+
+  try {
+    ArResolver &resolver = ArGetResolver();
+    ArResolverContextBinder binder(
+        &resolver, resolver.CreateDefaultContextForAsset(assetPath));
+
+    // Only layers whose files changed since the last check are re-scanned.
+    USDInteropInternal::DependencyCache &cache =
+        USDInteropInternal::DependencyCache::GetInstance();
+    USDInteropInternal::DependencyWalk walk = cache.Walk(assetPath);
+    cache.Save();
+
+    report.success = walk.rootResolved;
+    report.unresolvedPaths = std::move(walk.unresolved);
+  } catch (const std::exception &e) {
+    report.unresolvedPaths.assign(
+        1, std::string("C++ exception: ") + e.what());
+  } catch (...) {
+    report.unresolvedPaths.assign(1, "Unknown C++ exception");
+  }
+  return report;
+}
+
+DependencyCheckResultCxx CheckDependenciesSimple(const std::string &assetPath) {
+  DependencyCheckReportCxx report = CheckDependenciesReport(assetPath);
+
+  DependencyCheckResultCxx result;
+  result.success = report.success;
+  result.unresolvedCount = report.GetUnresolvedCount();
+
+  // Cache unresolved paths
+  g_unresolvedCache = std::move(report.unresolvedPaths);
+  return result;
+}
+
+int DependencyCheckReportCxx::GetUnresolvedCount() const {
+  return static_cast<int>(unresolvedPaths.size());
+}
+
+std::string DependencyCheckReportCxx::GetUnresolvedPath(int index) const {
+  if (index < 0 || index >= GetUnresolvedCount()) {
+    return "";
+  }
+  return unresolvedPaths[index];
 }
 
 std::string GetUnresolvedPath(int index) {
@@ -147,172 +609,481 @@ std::string GetUnresolvedPath(int index) {
 
 void ClearUnresolvedCache() { g_unresolvedCache.clear(); }
 
+bool SetDependencyCacheFile(const std::string &path) {
+  return USDInteropInternal::DependencyCache::GetInstance().SetPersistentPath(
+      path);
+}
+
+void ClearDependencyCache() {
+  USDInteropInternal::DependencyCache::GetInstance().Clear();
+}
+
+namespace {
+/// Interns audit dependencies so each path is stored once.
+class DependencyAuditTable {
+ public:
+  explicit DependencyAuditTable(
+      std::vector<DependencyAuditDependencyCxx> &dependencies)
+      : _dependencies(dependencies) {}
+
+  int Add(const std::string &path, int kind) {
+    const auto inserted =
+        _indices.emplace(path, static_cast<int>(_dependencies.size()));
+    if (inserted.second) {
+      _dependencies.push_back(DependencyAuditDependencyCxx{path, kind, 0});
+    }
+    _dependencies[inserted.first->second].assetCount += 1;
+    return inserted.first->second;
+  }
+
+ private:
+  std::vector<DependencyAuditDependencyCxx> &_dependencies;
+  std::unordered_map<std::string, int> _indices;
+};
+
+bool IsAuditedAssetExtension(const std::string &extension) {
+  return extension == "usd" || extension == "usda" || extension == "usdc" ||
+         extension == "usdz";
+}
+} // namespace
+
+DependencyAuditReportCxx
+AuditDependencies(const std::vector<std::string> &assetPaths) {
+  DependencyAuditReportCxx report;
+  std::vector<USDInteropInternal::DependencyWalk> walks(assetPaths.size());
+  USDInteropInternal::DependencyCache &cache =
+      USDInteropInternal::DependencyCache::GetInstance();
+
+  WorkParallelForN(assetPaths.size(), [&](size_t begin, size_t end) {
+    ArResolver &resolver = ArGetResolver();
+    for (size_t i = begin; i < end; ++i) {
+      USDInteropInternal::DependencyWalk &walk = walks[i];
+      try {
+        ArResolverContextBinder binder(
+            &resolver, resolver.CreateDefaultContextForAsset(assetPaths[i]));
+        walk = cache.Walk(assetPaths[i]);
+      } catch (const std::exception &e) {
+        walk = USDInteropInternal::DependencyWalk();
+        walk.unresolved.push_back(std::string("C++ exception: ") + e.what());
+      } catch (...) {
+        walk = USDInteropInternal::DependencyWalk();
+        walk.unresolved.push_back("Unknown C++ exception");
+      }
+    }
+  });
+  cache.Save();
+
+  // Build the shared table on one thread, in input order, so indices are
+  // stable from run to run.
+  DependencyAuditTable table(report.dependencies);
+  report.assets.reserve(walks.size());
+  for (size_t i = 0; i < walks.size(); ++i) {
+    const USDInteropInternal::DependencyWalk &walk = walks[i];
+    DependencyAuditAssetCxx asset;
+    asset.assetPath = assetPaths[i];
+    asset.success = walk.rootResolved && walk.unresolved.empty();
+    for (size_t layer = 1; layer < walk.layers.size(); ++layer) {
+      asset.dependencyIndices.push_back(
+          table.Add(walk.layers[layer], DependencyKindLayer));
+    }
+    for (const std::string &path : walk.assets) {
+      asset.dependencyIndices.push_back(table.Add(path, DependencyKindAsset));
+    }
+    for (const std::string &path : walk.unresolved) {
+      const int index = table.Add(path, DependencyKindUnresolved);
+      asset.dependencyIndices.push_back(index);
+      asset.unresolvedIndices.push_back(index);
+    }
+    report.assets.push_back(std::move(asset));
+  }
+  return report;
+}
+
+DependencyAuditReportCxx
+AuditDependenciesInDirectory(const std::string &directory) {
+  std::vector<std::string> assetPaths;
+  std::error_code error;
+  std::filesystem::recursive_directory_iterator it(
+      directory, std::filesystem::directory_options::skip_permission_denied,
+      error);
+  for (; !error && it != std::filesystem::recursive_directory_iterator();
+       it.increment(error)) {
+    if (!it->is_regular_file(error)) {
+      continue;
+    }
+    const std::string path = it->path().string();
+    if (IsAuditedAssetExtension(TfGetExtension(path))) {
+      assetPaths.push_back(path);
+    }
+  }
+  std::sort(assetPaths.begin(), assetPaths.end());
+  return AuditDependencies(assetPaths);
+}
+
+int DependencyAuditReportCxx::GetFailedAssetCount() const {
+  int count = 0;
+  for (const DependencyAuditAssetCxx &asset : assets) {
+    if (!asset.success) {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+std::string DependencyAuditReportCxx::GetUnresolvedPath(int assetIndex,
+                                                        int index) const {
+  if (assetIndex < 0 || assetIndex >= static_cast<int>(assets.size())) {
+    return "";
+  }
+  const std::vector<int> &unresolved = assets[assetIndex].unresolvedIndices;
+  if (index < 0 || index >= static_cast<int>(unresolved.size())) {
+    return "";
+  }
+  return dependencies[unresolved[index]].path;
+}
+
 bool CreateUsdzPackageNative(const std::string &assetPath,
                              const std::string &outputPath) {
-  return CreateUsdzPackageNativeDetailed(assetPath, outputPath).success;
+  return CreateUsdzPackageNativeReport(assetPath, outputPath).summary.success;
 }
 
-UsdzPackagingResultCxx CreateUsdzPackageNativeDetailed(
+UsdzPackagingReportCxx CreateUsdzPackageNativeReport(
     const std::string &assetPath,
     const std::string &outputPath) {
-  UsdzPackagingResultCxx result;
-  result.success = false;
-  result.diagnosticCount = 0;
-  result.warningCount = 0;
-  result.errorCount = 0;
-  result.failedAssetCount = 0;
-
-  ClearPackagingCaches();
+  PackagingDiagnosticsCollector diagnostics;
+  bool success = false;
   try {
-    PackagingDiagnosticDelegate delegate;
-    ScopedPackagingDelegateRegistration registration(&delegate);
+    ScopedPackagingDiagnostics scope(diagnostics);
     SdfAssetPath sdfAssetPath(assetPath);
-    result.success = UsdUtilsCreateNewUsdzPackage(
+    success = UsdUtilsCreateNewUsdzPackage(
         sdfAssetPath, outputPath, std::string(), false);
-    result.diagnosticCount =
-        static_cast<int>(g_packagingDiagnosticCache.size());
-    result.failedAssetCount =
-        static_cast<int>(g_packagingFailedAssetPathCache.size());
-    for (const auto &diagnostic : g_packagingDiagnosticCache) {
-      if (diagnostic.severity == 1) {
-        result.warningCount += 1;
-      } else if (diagnostic.severity >= 2) {
-        result.errorCount += 1;
+    scope.Finish();
+  } catch (const std::exception &e) {
+    diagnostics.AddDiagnostic(2, std::string("C++ exception: ") + e.what());
+  } catch (...) {
+    diagnostics.AddDiagnostic(2, "Unknown C++ exception");
+  }
+  return MakePackagingReport(success, diagnostics);
+}
+
+UsdzPackagingResultCxx CreateUsdzPackageNativeDetailed(
+    const std::string &assetPath,
+    const std::string &outputPath) {
+  return StoreLegacyPackagingReport(
+      CreateUsdzPackageNativeReport(assetPath, outputPath));
+}
+
+namespace {
+UsdzPackagingReportCxx CreateUsdzPackagePipelinedImpl(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    bool incremental,
+    UsdzPackagingProgressCallback progress,
+    void *context) {
+  PackagingDiagnosticsCollector diagnostics;
+  bool success = false;
+
+  UsdzPackagingProgressCxx state = {};
+  state.stage = UsdzPackagingStageDiscovering;
+
+  try {
+    std::vector<PackageEntry> entries;
+    bool collected = false;
+    {
+      ScopedPackagingDiagnostics scope(diagnostics);
+      const auto discoveryStart = std::chrono::steady_clock::now();
+      collected = CollectPackageEntries(assetPath, entries);
+      state.discoverySeconds = SecondsSince(discoveryStart);
+      scope.Finish();
+    }
+
+    if (!collected) {
+      // Needs asset path rewriting; let UsdUtils build the package.
+      const auto writeStart = std::chrono::steady_clock::now();
+      UsdzPackagingReportCxx report =
+          CreateUsdzPackageNativeReport(assetPath, outputPath);
+      state.writeSeconds = SecondsSince(writeStart);
+      state.stage = UsdzPackagingStageFinished;
+      if (progress) {
+        progress(state, context);
       }
+      return report;
     }
-    return result;
+
+    state.totalEntries = static_cast<int>(entries.size());
+    for (const PackageEntry &entry : entries) {
+      state.totalBytes += static_cast<int64_t>(entry.size);
+    }
+    if (progress) {
+      progress(state, context);
+    }
+
+    // The previous package stays mapped while its replacement is written to
+    // a temporary file, so unchanged entries are copied straight from it.
+    USDInteropInternal::UsdzArchiveReader previous;
+    const bool hasPrevious = incremental && previous.Open(outputPath);
+
+    state.stage = UsdzPackagingStageWriting;
+    success = WritePackageEntries(entries, hasPrevious ? &previous : nullptr,
+                                  outputPath, state, progress, context,
+                                  diagnostics);
   } catch (const std::exception &e) {
-    g_packagingDiagnosticCache.push_back(
-        PackagingDiagnosticCacheItem{2, std::string("C++ exception: ") + e.what()});
-    result.diagnosticCount = 1;
-    result.errorCount = 1;
-    return result;
+    diagnostics.AddDiagnostic(2, std::string("C++ exception: ") + e.what());
   } catch (...) {
-    g_packagingDiagnosticCache.push_back(
-        PackagingDiagnosticCacheItem{2, "Unknown C++ exception"});
-    result.diagnosticCount = 1;
-    result.errorCount = 1;
-    return result;
+    diagnostics.AddDiagnostic(2, "Unknown C++ exception");
   }
+
+  state.stage = UsdzPackagingStageFinished;
+  if (progress) {
+    progress(state, context);
+  }
+  UsdzPackagingReportCxx report = MakePackagingReport(success, diagnostics);
+  report.reusedEntries = state.reusedEntries;
+  report.reusedBytes = state.reusedBytes;
+  return report;
 }
+} // namespace
 
-std::string GetPackagingDiagnosticMessage(int index) {
-  if (index < 0 || index >= static_cast<int>(g_packagingDiagnosticCache.size())) {
+UsdzPackagingReportCxx CreateUsdzPackagePipelinedReport(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context) {
+  return CreateUsdzPackagePipelinedImpl(assetPath, outputPath, false,
+                                        progress, context);
+}
+
+UsdzPackagingReportCxx UpdateUsdzPackageIncrementalReport(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context) {
+  return CreateUsdzPackagePipelinedImpl(assetPath, outputPath, true,
+                                        progress, context);
+}
+
+UsdzPackagingResultCxx CreateUsdzPackagePipelined(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context) {
+  return StoreLegacyPackagingReport(CreateUsdzPackagePipelinedReport(
+      assetPath, outputPath, progress, context));
+}
+
+UsdzPackagingResultCxx UpdateUsdzPackageIncremental(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context) {
+  return StoreLegacyPackagingReport(UpdateUsdzPackageIncrementalReport(
+      assetPath, outputPath, progress, context));
+}
+
+int PackagingDiagnosticsCxx::GetDiagnosticCount() const {
+  return static_cast<int>(diagnostics.size());
+}
+
+std::string PackagingDiagnosticsCxx::GetMessage(int index) const {
+  if (index < 0 || index >= GetDiagnosticCount()) {
     return "";
   }
-  return g_packagingDiagnosticCache[index].message;
+  const PackagingDiagnosticRecordCxx &record = diagnostics[index];
+  return text.substr(record.messageOffset, record.messageLength);
 }
 
-int GetPackagingDiagnosticSeverity(int index) {
-  if (index < 0 || index >= static_cast<int>(g_packagingDiagnosticCache.size())) {
+int PackagingDiagnosticsCxx::GetSeverity(int index) const {
+  if (index < 0 || index >= GetDiagnosticCount()) {
     return -1;
   }
-  return g_packagingDiagnosticCache[index].severity;
+  return diagnostics[index].severity;
 }
 
-std::string GetPackagingFailedAssetPath(int index) {
-  if (index < 0 ||
-      index >= static_cast<int>(g_packagingFailedAssetPathCache.size())) {
+int PackagingDiagnosticsCxx::GetFailedAssetCount() const {
+  return static_cast<int>(failedAssetPathOffsets.size());
+}
+
+std::string PackagingDiagnosticsCxx::GetFailedAssetPath(int index) const {
+  if (index < 0 || index >= GetFailedAssetCount()) {
     return "";
   }
-  return g_packagingFailedAssetPathCache[index];
+  return std::string(text.c_str() + failedAssetPathOffsets[index]);
 }
 
-void ClearPackagingDiagnosticCache() {
-  ClearPackagingCaches();
+std::string GetPackagingDiagnosticMessage(int index) {
+  return g_packagingDiagnostics.GetMessage(index);
 }
 
-namespace USDInterop {
-bool RewriteAttributeSpecTypeToString(const USD::SdfLayerHandle &layer,
-                                      const USD::SdfPath &attrPath) {
-  if (!layer) {
-    return false;
-  }
+int GetPackagingDiagnosticSeverity(int index) {
+  return g_packagingDiagnostics.GetSeverity(index);
+}
 
-  pxr::SdfAttributeSpecHandle attrSpec = layer->GetAttributeAtPath(attrPath);
-  if (!attrSpec) {
-    return false;
-  }
+std::string GetPackagingFailedAssetPath(int index) {
+  return g_packagingDiagnostics.GetFailedAssetPath(index);
+}
+
+PackagingDiagnosticsCxx GetPackagingDiagnostics() {
+  return g_packagingDiagnostics;
+}
 
-  pxr::SdfPrimSpecHandle owner = layer->GetPrimAtPath(attrPath.GetPrimPath());
+void ClearPackagingDiagnosticCache() {
+  g_packagingDiagnostics = PackagingDiagnosticsCxx();
+}
+
+namespace {
+/// Replaces an attribute spec with a `string` spec of the same name,
+/// variability and custom-ness, keeping a `string` or `token` default.
+bool ReplaceAttributeSpecWithString(const SdfAttributeSpecHandle &attrSpec) {
+  const SdfPath attrPath = attrSpec->GetPath();
+  SdfPrimSpecHandle owner =
+      attrSpec->GetLayer()->GetPrimAtPath(attrPath.GetPrimPath());
   if (!owner) {
     return false;
   }
 
-  const pxr::SdfVariability variability = attrSpec->GetVariability();
+  const SdfVariability variability = attrSpec->GetVariability();
   const bool isCustom = attrSpec->IsCustom();
 
   bool hasDefaultValue = attrSpec->HasDefaultValue();
   std::string defaultStringValue;
   if (hasDefaultValue) {
-    const pxr::VtValue defaultValue = attrSpec->GetDefaultValue();
+    const VtValue defaultValue = attrSpec->GetDefaultValue();
     if (defaultValue.IsHolding<std::string>()) {
       defaultStringValue = defaultValue.UncheckedGet<std::string>();
-    } else if (defaultValue.IsHolding<pxr::TfToken>()) {
-      defaultStringValue = defaultValue.UncheckedGet<pxr::TfToken>().GetString();
+    } else if (defaultValue.IsHolding<TfToken>()) {
+      defaultStringValue = defaultValue.UncheckedGet<TfToken>().GetString();
     } else {
       hasDefaultValue = false;
     }
   }
 
+  // New fails if the old spec is still present, so it doubles as the
+  // removal check.
   owner->RemoveProperty(attrSpec);
-  if (layer->GetAttributeAtPath(attrPath)) {
-    return false;
-  }
-
-  pxr::SdfAttributeSpecHandle rewritten = pxr::SdfAttributeSpec::New(
-      owner,
-      attrPath.GetName(),
-      pxr::SdfValueTypeNames->String,
-      variability,
-      isCustom);
+  SdfAttributeSpecHandle rewritten =
+      SdfAttributeSpec::New(owner, attrPath.GetName(),
+                            SdfValueTypeNames->String, variability, isCustom);
   if (!rewritten) {
     return false;
   }
 
   if (hasDefaultValue) {
-    rewritten->SetDefaultValue(pxr::VtValue(defaultStringValue));
+    rewritten->SetDefaultValue(VtValue(defaultStringValue));
   }
-
   return true;
 }
 
+using TokenSet = std::unordered_set<TfToken, TfToken::HashFunctor>;
+
+/// Paths of token-typed attribute specs named in `propertyNames`. Reads
+/// fields directly so no spec handles are created while scanning.
+std::vector<SdfPath> FindTokenAttributeSpecs(const SdfLayerHandle &layer,
+                                             const TokenSet &propertyNames) {
+  std::vector<SdfPath> paths;
+  const TfToken tokenTypeName = SdfValueTypeNames->Token.GetAsToken();
+  layer->Traverse(SdfPath::AbsoluteRootPath(), [&](const SdfPath &path) {
+    if (!path.IsPrimPropertyPath() ||
+        propertyNames.find(path.GetNameToken()) == propertyNames.end() ||
+        layer->GetSpecType(path) != SdfSpecTypeAttribute) {
+      return;
+    }
+    if (layer->GetFieldAs<TfToken>(path, SdfFieldKeys->TypeName) ==
+        tokenTypeName) {
+      paths.push_back(path);
+    }
+  });
+  return paths;
+}
+} // namespace
+
+namespace USDInterop {
+bool RewriteAttributeSpecTypeToString(const USD::SdfLayerHandle &layer,
+                                      const USD::SdfPath &attrPath) {
+  if (!layer) {
+    return false;
+  }
+
+  pxr::SdfAttributeSpecHandle attrSpec = layer->GetAttributeAtPath(attrPath);
+  if (!attrSpec) {
+    return false;
+  }
+  return ReplaceAttributeSpecWithString(attrSpec);
+}
+
 int RewriteAllTokenAttributeSpecsToString(const USD::SdfLayerHandle &layer,
                                           const std::string &propertyName) {
   if (!layer || propertyName.empty()) {
     return 0;
   }
+  return RewriteTokenAttributeSpecsToString(
+      USD::SdfLayerHandleVector{layer}, std::vector<std::string>{propertyName},
+      false);
+}
 
-  const pxr::TfToken propertyToken(propertyName);
-  std::vector<pxr::SdfPath> pathsToRewrite;
-  layer->Traverse(pxr::SdfPath::AbsoluteRootPath(),
-                  [&](const pxr::SdfPath &path) {
-                    if (!path.IsPropertyPath()) {
-                      return;
-                    }
-                    if (path.GetNameToken() != propertyToken) {
-                      return;
-                    }
+int RewriteTokenAttributeSpecsToString(
+    const USD::SdfLayerHandleVector &layers,
+    const std::vector<std::string> &propertyNames,
+    bool dryRun) {
+  TokenSet names;
+  for (const std::string &name : propertyNames) {
+    if (!name.empty()) {
+      names.insert(TfToken(name));
+    }
+  }
+  if (names.empty() || layers.empty()) {
+    return 0;
+  }
 
-                    const pxr::SdfAttributeSpecHandle attrSpec =
-                        layer->GetAttributeAtPath(path);
-                    if (!attrSpec) {
-                      return;
-                    }
-                    if (attrSpec->GetTypeName() != pxr::SdfValueTypeNames->Token) {
-                      return;
-                    }
+  try {
+    // A layer listed twice, e.g. sublayered from two places, would be
+    // scanned twice and its specs counted twice in a dry run.
+    std::unordered_set<const SdfLayer *> seen;
+    SdfLayerHandleVector uniqueLayers;
+    uniqueLayers.reserve(layers.size());
+    for (const SdfLayerHandle &layer : layers) {
+      if (layer && seen.insert(get_pointer(layer)).second) {
+        uniqueLayers.push_back(layer);
+      }
+    }
 
-                    pathsToRewrite.push_back(path);
-                  });
+    // Scanning only reads, so layers are traversed concurrently; Sdf edits
+    // are not thread-safe and are applied afterwards on this thread.
+    std::vector<std::vector<SdfPath>> paths(uniqueLayers.size());
+    WorkParallelForN(uniqueLayers.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        paths[i] = FindTokenAttributeSpecs(uniqueLayers[i], names);
+      }
+    });
+
+    int count = 0;
+    if (dryRun) {
+      for (const std::vector<SdfPath> &layerPaths : paths) {
+        count += static_cast<int>(layerPaths.size());
+      }
+      return count;
+    }
 
-  int rewrittenCount = 0;
-  for (const pxr::SdfPath &path : pathsToRewrite) {
-    if (RewriteAttributeSpecTypeToString(layer, path)) {
-      ++rewrittenCount;
+    SdfChangeBlock changeBlock;
+    for (size_t i = 0; i < uniqueLayers.size(); ++i) {
+      for (const SdfPath &path : paths[i]) {
+        const SdfAttributeSpecHandle attrSpec =
+            uniqueLayers[i]->GetAttributeAtPath(path);
+        if (attrSpec && ReplaceAttributeSpecWithString(attrSpec)) {
+          ++count;
+        }
+      }
     }
+    return count;
+  } catch (...) {
+    return 0;
   }
+}
 
-  return rewrittenCount;
+int RewriteTokenAttributeSpecsToString(
+    const USD::UsdStage &stage,
+    const std::vector<std::string> &propertyNames,
+    bool dryRun) {
+  return RewriteTokenAttributeSpecsToString(stage.GetLayerStack(true),
+                                            propertyNames, dryRun);
 }
 } // namespace USDInterop
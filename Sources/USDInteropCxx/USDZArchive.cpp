@@ -0,0 +1,391 @@
+#include "USDZArchive.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr uint32_t kLocalFileHeaderSignature = 0x04034b50u;
+constexpr uint32_t kCentralDirectorySignature = 0x02014b50u;
+constexpr uint32_t kEndOfCentralDirectorySignature = 0x06054b50u;
+constexpr size_t kLocalFileHeaderSize = 30;
+// Extra field id used for alignment padding, matching OpenUSD's writer.
+constexpr uint16_t kPaddingExtraFieldId = 0x1986;
+constexpr uint16_t kVersionNeededToExtract = 10;
+// Private central directory extra field holding a UsdzSourceStamp. Readers
+// that do not know the id skip it.
+constexpr uint16_t kSourceStampExtraFieldId = 0x5a55;
+constexpr uint16_t kSourceStampExtraFieldSize = 32;
+
+std::array<uint32_t, 256> MakeCrcTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t index = 0; index < 256; ++index) {
+    uint32_t value = index;
+    for (int bit = 0; bit < 8; ++bit) {
+      value = (value & 1u) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+    }
+    table[index] = value;
+  }
+  return table;
+}
+
+constexpr size_t kCentralDirectoryHeaderSize = 46;
+constexpr size_t kEndOfCentralDirectorySize = 22;
+
+uint16_t GetUInt16(const unsigned char *bytes) {
+  return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t GetUInt32(const unsigned char *bytes) {
+  return static_cast<uint32_t>(GetUInt16(bytes)) |
+         (static_cast<uint32_t>(GetUInt16(bytes + 2)) << 16);
+}
+
+void PutUInt16(std::vector<unsigned char> &out, uint16_t value) {
+  out.push_back(static_cast<unsigned char>(value & 0xff));
+  out.push_back(static_cast<unsigned char>((value >> 8) & 0xff));
+}
+
+uint64_t GetUInt64(const unsigned char *bytes) {
+  return static_cast<uint64_t>(GetUInt32(bytes)) |
+         (static_cast<uint64_t>(GetUInt32(bytes + 4)) << 32);
+}
+
+void PutUInt32(std::vector<unsigned char> &out, uint32_t value) {
+  PutUInt16(out, static_cast<uint16_t>(value & 0xffff));
+  PutUInt16(out, static_cast<uint16_t>((value >> 16) & 0xffff));
+}
+
+void PutUInt64(std::vector<unsigned char> &out, uint64_t value) {
+  PutUInt32(out, static_cast<uint32_t>(value & 0xffffffffu));
+  PutUInt32(out, static_cast<uint32_t>(value >> 32));
+}
+} // namespace
+
+namespace USDInteropInternal {
+uint32_t Crc32(uint32_t crc, const void *data, size_t size) {
+  static const std::array<uint32_t, 256> table = MakeCrcTable();
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  crc = ~crc;
+  for (size_t index = 0; index < size; ++index) {
+    crc = table[(crc ^ bytes[index]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+uint32_t DosDateTime(std::time_t time) {
+  std::tm local = {};
+  if (!localtime_r(&time, &local) || local.tm_year < 80) {
+    // Zip cannot represent dates before 1980.
+    return (1u << 21) | (1u << 16);
+  }
+  const uint32_t date = (static_cast<uint32_t>(local.tm_year - 80) << 9) |
+                        (static_cast<uint32_t>(local.tm_mon + 1) << 5) |
+                        static_cast<uint32_t>(local.tm_mday);
+  const uint32_t clock = (static_cast<uint32_t>(local.tm_hour) << 11) |
+                         (static_cast<uint32_t>(local.tm_min) << 5) |
+                         static_cast<uint32_t>(local.tm_sec / 2);
+  return (date << 16) | clock;
+}
+
+UsdzArchiveWriter::~UsdzArchiveWriter() {
+  Discard();
+}
+
+bool UsdzArchiveWriter::Open(const std::string &path) {
+  Discard();
+  _path = path;
+  _tempPath = path + ".tmp";
+  _file = std::fopen(_tempPath.c_str(), "wb");
+  if (!_file) {
+    return false;
+  }
+  std::setvbuf(_file, nullptr, _IOFBF, 1 << 20);
+  _offset = 0;
+  _entries.clear();
+  return true;
+}
+
+bool UsdzArchiveWriter::Write(const void *data, size_t size) {
+  if (size == 0) {
+    return true;
+  }
+  if (std::fwrite(data, 1, size, _file) != size) {
+    return false;
+  }
+  _offset += size;
+  return true;
+}
+
+bool UsdzArchiveWriter::AddEntry(const std::string &name, const void *data,
+                                 size_t size, uint32_t crc,
+                                 uint32_t dosDateTime,
+                                 const UsdzSourceStamp *sourceStamp) {
+  constexpr uint64_t kMaxOffset = std::numeric_limits<uint32_t>::max();
+  if (!_file || name.empty() ||
+      name.size() > std::numeric_limits<uint16_t>::max() ||
+      (!data && size != 0)) {
+    return false;
+  }
+
+  // Pad the local header's extra field so the entry data is aligned. An
+  // extra field needs at least its 4-byte header, so small gaps grow by a
+  // full alignment step.
+  const uint64_t unpaddedDataOffset =
+      _offset + kLocalFileHeaderSize + name.size();
+  size_t padding =
+      (kDataAlignment - unpaddedDataOffset % kDataAlignment) % kDataAlignment;
+  if (padding != 0 && padding < 4) {
+    padding += kDataAlignment;
+  }
+  if (_offset > kMaxOffset || unpaddedDataOffset + padding + size > kMaxOffset) {
+    // USDZ does not allow Zip64.
+    return false;
+  }
+
+  std::vector<unsigned char> header;
+  header.reserve(kLocalFileHeaderSize + name.size() + padding);
+  PutUInt32(header, kLocalFileHeaderSignature);
+  PutUInt16(header, kVersionNeededToExtract);
+  PutUInt16(header, 0); // flags
+  PutUInt16(header, 0); // stored
+  PutUInt16(header, static_cast<uint16_t>(dosDateTime & 0xffff));
+  PutUInt16(header, static_cast<uint16_t>(dosDateTime >> 16));
+  PutUInt32(header, crc);
+  PutUInt32(header, static_cast<uint32_t>(size));
+  PutUInt32(header, static_cast<uint32_t>(size));
+  PutUInt16(header, static_cast<uint16_t>(name.size()));
+  PutUInt16(header, static_cast<uint16_t>(padding));
+  header.insert(header.end(), name.begin(), name.end());
+  if (padding != 0) {
+    PutUInt16(header, kPaddingExtraFieldId);
+    PutUInt16(header, static_cast<uint16_t>(padding - 4));
+    header.resize(header.size() + padding - 4, 0);
+  }
+
+  const uint32_t localHeaderOffset = static_cast<uint32_t>(_offset);
+  if (!Write(header.data(), header.size()) || !Write(data, size)) {
+    return false;
+  }
+
+  _entries.push_back(CentralEntry{name, crc, static_cast<uint32_t>(size),
+                                  dosDateTime, localHeaderOffset,
+                                  sourceStamp != nullptr,
+                                  sourceStamp ? *sourceStamp
+                                              : UsdzSourceStamp()});
+  return true;
+}
+
+bool UsdzArchiveWriter::Close() {
+  if (!_file) {
+    return false;
+  }
+  if (_entries.size() > std::numeric_limits<uint16_t>::max()) {
+    Discard();
+    return false;
+  }
+
+  const uint64_t centralDirectoryOffset = _offset;
+  std::vector<unsigned char> directory;
+  for (const CentralEntry &entry : _entries) {
+    PutUInt32(directory, kCentralDirectorySignature);
+    PutUInt16(directory, kVersionNeededToExtract); // version made by
+    PutUInt16(directory, kVersionNeededToExtract);
+    PutUInt16(directory, 0); // flags
+    PutUInt16(directory, 0); // stored
+    PutUInt16(directory, static_cast<uint16_t>(entry.dosDateTime & 0xffff));
+    PutUInt16(directory, static_cast<uint16_t>(entry.dosDateTime >> 16));
+    PutUInt32(directory, entry.crc);
+    PutUInt32(directory, entry.size);
+    PutUInt32(directory, entry.size);
+    PutUInt16(directory, static_cast<uint16_t>(entry.name.size()));
+    PutUInt16(directory, entry.hasSourceStamp
+                             ? 4 + kSourceStampExtraFieldSize
+                             : 0); // extra field length
+    PutUInt16(directory, 0); // comment length
+    PutUInt16(directory, 0); // disk number
+    PutUInt16(directory, 0); // internal attributes
+    PutUInt32(directory, 0); // external attributes
+    PutUInt32(directory, entry.localHeaderOffset);
+    directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+    if (entry.hasSourceStamp) {
+      PutUInt16(directory, kSourceStampExtraFieldId);
+      PutUInt16(directory, kSourceStampExtraFieldSize);
+      PutUInt64(directory, entry.sourceStamp.size);
+      PutUInt64(directory,
+                static_cast<uint64_t>(entry.sourceStamp.mtimeNanoseconds));
+      PutUInt64(directory, entry.sourceStamp.inode);
+      PutUInt64(directory, entry.sourceStamp.device);
+    }
+  }
+
+  const uint32_t directorySize = static_cast<uint32_t>(directory.size());
+  const uint16_t entryCount = static_cast<uint16_t>(_entries.size());
+  PutUInt32(directory, kEndOfCentralDirectorySignature);
+  PutUInt16(directory, 0); // this disk
+  PutUInt16(directory, 0); // central directory disk
+  PutUInt16(directory, entryCount);
+  PutUInt16(directory, entryCount);
+  PutUInt32(directory, directorySize);
+  PutUInt32(directory, static_cast<uint32_t>(centralDirectoryOffset));
+  PutUInt16(directory, 0); // comment length
+
+  if (centralDirectoryOffset > std::numeric_limits<uint32_t>::max() ||
+      !Write(directory.data(), directory.size())) {
+    Discard();
+    return false;
+  }
+
+  const bool flushed = std::fclose(_file) == 0;
+  _file = nullptr;
+  if (!flushed || std::rename(_tempPath.c_str(), _path.c_str()) != 0) {
+    std::remove(_tempPath.c_str());
+    return false;
+  }
+  _entries.clear();
+  return true;
+}
+
+void UsdzArchiveWriter::Discard() {
+  if (!_file) {
+    return;
+  }
+  std::fclose(_file);
+  _file = nullptr;
+  std::remove(_tempPath.c_str());
+  _entries.clear();
+}
+} // namespace USDInteropInternal
+
+namespace USDInteropInternal {
+UsdzArchiveReader::~UsdzArchiveReader() {
+  Close();
+}
+
+void UsdzArchiveReader::Close() {
+  if (_mapping) {
+    munmap(_mapping, _mappingSize);
+  }
+  _mapping = nullptr;
+  _mappingSize = 0;
+  _entries.clear();
+}
+
+bool UsdzArchiveReader::Open(const std::string &path) {
+  Close();
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info = {};
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < kEndOfCentralDirectorySize) {
+    ::close(fd);
+    return false;
+  }
+  const size_t fileSize = static_cast<size_t>(info.st_size);
+  void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  _mapping = mapping;
+  _mappingSize = fileSize;
+
+  const auto *bytes = static_cast<const unsigned char *>(_mapping);
+
+  // The end record sits before an optional trailing comment of up to 64 KiB.
+  size_t endRecord = fileSize - kEndOfCentralDirectorySize;
+  const size_t searchFloor =
+      endRecord > 0xffff ? endRecord - 0xffff : 0;
+  while (GetUInt32(bytes + endRecord) != kEndOfCentralDirectorySignature) {
+    if (endRecord == searchFloor) {
+      Close();
+      return false;
+    }
+    --endRecord;
+  }
+
+  const uint16_t entryCount = GetUInt16(bytes + endRecord + 10);
+  size_t cursor = GetUInt32(bytes + endRecord + 16);
+  for (uint16_t index = 0; index < entryCount; ++index) {
+    if (cursor + kCentralDirectoryHeaderSize > endRecord ||
+        GetUInt32(bytes + cursor) != kCentralDirectorySignature) {
+      Close();
+      return false;
+    }
+    const unsigned char *header = bytes + cursor;
+    const uint16_t method = GetUInt16(header + 10);
+    const uint32_t dosDateTime =
+        GetUInt16(header + 12) | (static_cast<uint32_t>(GetUInt16(header + 14)) << 16);
+    const uint32_t crc = GetUInt32(header + 16);
+    const uint32_t compressedSize = GetUInt32(header + 20);
+    const uint32_t size = GetUInt32(header + 24);
+    const uint16_t nameLength = GetUInt16(header + 28);
+    const uint16_t extraLength = GetUInt16(header + 30);
+    const size_t recordSize = kCentralDirectoryHeaderSize + nameLength +
+                              extraLength + GetUInt16(header + 32);
+    const size_t localHeader = GetUInt32(header + 42);
+    if (cursor + recordSize > endRecord) {
+      Close();
+      return false;
+    }
+    std::string name(reinterpret_cast<const char *>(header) +
+                         kCentralDirectoryHeaderSize,
+                     nameLength);
+    cursor += recordSize;
+
+    bool hasSourceStamp = false;
+    UsdzSourceStamp sourceStamp;
+    const unsigned char *extra =
+        header + kCentralDirectoryHeaderSize + nameLength;
+    for (size_t offset = 0; offset + 4 <= extraLength;) {
+      const uint16_t id = GetUInt16(extra + offset);
+      const uint16_t fieldSize = GetUInt16(extra + offset + 2);
+      if (offset + 4 + fieldSize > extraLength) {
+        break;
+      }
+      if (id == kSourceStampExtraFieldId &&
+          fieldSize == kSourceStampExtraFieldSize) {
+        const unsigned char *field = extra + offset + 4;
+        sourceStamp.size = GetUInt64(field);
+        sourceStamp.mtimeNanoseconds =
+            static_cast<int64_t>(GetUInt64(field + 8));
+        sourceStamp.inode = GetUInt64(field + 16);
+        sourceStamp.device = GetUInt64(field + 24);
+        hasSourceStamp = true;
+      }
+      offset += 4 + fieldSize;
+    }
+
+    if (method != 0 || compressedSize != size ||
+        localHeader + kLocalFileHeaderSize > fileSize ||
+        GetUInt32(bytes + localHeader) != kLocalFileHeaderSignature) {
+      continue;
+    }
+    const size_t dataOffset = localHeader + kLocalFileHeaderSize +
+                              GetUInt16(bytes + localHeader + 26) +
+                              GetUInt16(bytes + localHeader + 28);
+    if (dataOffset + size > fileSize) {
+      continue;
+    }
+    _entries[std::move(name)] =
+        Entry{reinterpret_cast<const char *>(bytes + dataOffset), size, crc,
+              dosDateTime, hasSourceStamp, sourceStamp};
+  }
+  return true;
+}
+
+const UsdzArchiveReader::Entry *
+UsdzArchiveReader::Find(const std::string &name) const {
+  const auto found = _entries.find(name);
+  return found != _entries.end() ? &found->second : nullptr;
+}
+} // namespace USDInteropInternal
@@ -0,0 +1,122 @@
+#ifndef USDINTEROP_USDZ_ARCHIVE_HPP
+#define USDINTEROP_USDZ_ARCHIVE_HPP
+
+// Minimal reader and writer for the zip subset USDZ allows: stored (uncompressed)
+// entries whose data starts on a 64-byte boundary. Private to USDInteropCxx.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace USDInteropInternal {
+/// Updates a CRC-32 (zip polynomial) with `size` bytes. Start from 0.
+uint32_t Crc32(uint32_t crc, const void *data, size_t size);
+
+/// Packs a timestamp into the MS-DOS time (low 16 bits) and date (high 16
+/// bits) used by zip headers, in local time.
+uint32_t DosDateTime(std::time_t time);
+
+/// Identity of the file an entry was copied from, as of when it was read.
+/// Stored in a private extra field of the central directory so a rebuild can
+/// reuse the entry without opening a source whose stamp still matches.
+struct UsdzSourceStamp {
+  uint64_t size = 0;
+  int64_t mtimeNanoseconds = 0;
+  uint64_t inode = 0;
+  uint64_t device = 0;
+
+  bool operator==(const UsdzSourceStamp &other) const {
+    return size == other.size && mtimeNanoseconds == other.mtimeNanoseconds &&
+           inode == other.inode && device == other.device;
+  }
+};
+
+/// Writes a USDZ archive entry by entry, in the order entries are added.
+/// Output goes to a temporary file that replaces `path` only on `Close`.
+class UsdzArchiveWriter {
+ public:
+  static constexpr size_t kDataAlignment = 64;
+
+  UsdzArchiveWriter() = default;
+  ~UsdzArchiveWriter();
+
+  UsdzArchiveWriter(const UsdzArchiveWriter &) = delete;
+  UsdzArchiveWriter &operator=(const UsdzArchiveWriter &) = delete;
+
+  bool Open(const std::string &path);
+
+  /// Appends a stored entry. `crc` must be the CRC-32 of `data`.
+  /// `sourceStamp`, when given, is recorded for `UsdzArchiveReader`.
+  bool AddEntry(const std::string &name, const void *data, size_t size,
+                uint32_t crc, uint32_t dosDateTime,
+                const UsdzSourceStamp *sourceStamp = nullptr);
+
+  /// Writes the central directory and moves the archive into place.
+  bool Close();
+
+  /// Abandons the archive and removes the temporary file.
+  void Discard();
+
+  uint64_t BytesWritten() const { return _offset; }
+
+ private:
+  struct CentralEntry {
+    std::string name;
+    uint32_t crc;
+    uint32_t size;
+    uint32_t dosDateTime;
+    uint32_t localHeaderOffset;
+    bool hasSourceStamp;
+    UsdzSourceStamp sourceStamp;
+  };
+
+  bool Write(const void *data, size_t size);
+
+  std::string _path;
+  std::string _tempPath;
+  std::FILE *_file = nullptr;
+  uint64_t _offset = 0;
+  std::vector<CentralEntry> _entries;
+};
+
+/// Read-only, memory-mapped view of an existing archive's stored entries,
+/// used to copy unchanged entries into a rebuilt package without reading
+/// their sources again. Compressed entries are ignored.
+class UsdzArchiveReader {
+ public:
+  struct Entry {
+    const char *data;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t dosDateTime;
+    bool hasSourceStamp;
+    UsdzSourceStamp sourceStamp;
+  };
+
+  UsdzArchiveReader() = default;
+  ~UsdzArchiveReader();
+
+  UsdzArchiveReader(const UsdzArchiveReader &) = delete;
+  UsdzArchiveReader &operator=(const UsdzArchiveReader &) = delete;
+
+  /// Maps `path` and indexes its central directory. Returns false when the
+  /// file is missing or is not a readable zip archive.
+  bool Open(const std::string &path);
+
+  /// Returns the stored entry named `name`, or null.
+  const Entry *Find(const std::string &name) const;
+
+ private:
+  void Close();
+
+  void *_mapping = nullptr;
+  size_t _mappingSize = 0;
+  std::unordered_map<std::string, Entry> _entries;
+};
+} // namespace USDInteropInternal
+
+#endif // USDINTEROP_USDZ_ARCHIVE_HPP
@@ -2,6 +2,7 @@
 #define USDINTEROPCXX_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 #include "USDUtilsHelper.hpp"
@@ -17,6 +18,25 @@ typedef struct {
     int hasGeometry;  // 1 if valid, 0 if no geometry
 } USDInteropBounds;
 
+/// Strategies that contributed to a fast bounds result (bit flags).
+enum {
+    USDINTEROP_BOUNDS_EXTENTS_HINT = 1 << 0,
+    USDINTEROP_BOUNDS_AUTHORED_EXTENT = 1 << 1,
+    USDINTEROP_BOUNDS_COMPUTED_EXTENT = 1 << 2,
+    USDINTEROP_BOUNDS_LOADED_PAYLOAD = 1 << 3
+};
+
+/// Fast bounds result. `strategies` is a bitwise OR of the flags above and
+/// each count reports how many subtrees were bounded with that strategy.
+typedef struct {
+    USDInteropBounds bounds;
+    int strategies;
+    int extentsHintCount;
+    int authoredExtentCount;
+    int computedExtentCount;
+    int loadedPayloadCount;
+} USDInteropFastBounds;
+
 typedef struct {
     const char *layerIdentifier;
     const char *layerRealPath;
@@ -30,13 +50,198 @@ typedef struct {
     USDInteropSourceSite *sites;
 } USDInteropSourceSiteList;
 
+/// Array of C strings packed with its pointer table into one allocation.
+/// Entries may be NULL. Freed with `usdinterop_free_string_list`.
+typedef struct {
+    size_t count;
+    const char **strings;
+} USDInteropStringList;
+
+/// Header of the block returned by `usdinterop_scene_graph_binary`.
+/// Prims are stored in depth-first pre-order; every offset is in bytes from
+/// the start of the block, and every index array holds `primCount` entries.
+typedef struct {
+    uint32_t magic;               // USDINTEROP_SCENE_GRAPH_BINARY_MAGIC
+    uint32_t version;             // USDINTEROP_SCENE_GRAPH_BINARY_VERSION
+    uint32_t primCount;
+    uint32_t stringCount;
+    uint64_t totalSize;
+    uint64_t parentIndexOffset;   // int32_t, -1 for root prims
+    uint64_t firstChildOffset;    // int32_t, -1 for leaf prims
+    uint64_t nextSiblingOffset;   // int32_t, -1 for the last sibling
+    uint64_t nameIndexOffset;     // uint32_t index into the string table
+    uint64_t typeIndexOffset;     // int32_t index into the string table, -1 when untyped
+    uint64_t stringOffsetsOffset; // uint32_t[stringCount] offsets into string data
+    uint64_t stringDataOffset;    // NUL-terminated UTF-8 strings
+} USDInteropSceneGraphBinaryHeader;
+
+#define USDINTEROP_SCENE_GRAPH_BINARY_MAGIC 0x42475355u // "USGB"
+#define USDINTEROP_SCENE_GRAPH_BINARY_VERSION 1u
+
+/// Opaque, reference-counted handle to a composed stage.
+typedef struct usdinterop_stage_s usdinterop_stage_t;
+
+/// Initial payload load set used when composing a stage.
+typedef enum {
+    USDINTEROP_LOAD_ALL = 0,
+    USDINTEROP_LOAD_NONE = 1
+} USDInteropLoadSet;
+
+/// Opens a stage through the shared LRU stage cache and returns a retained
+/// handle. Repeated opens of an unchanged root layer with the same load set
+/// reuse the composed stage. When layer files changed on disk, only those
+/// layers are reloaded, waiting for running C API queries, and composition
+/// updates incrementally. This includes layers another handle kept in
+/// memory across the edit. As with `usdinterop_stage_refresh`, readers
+/// outside this API are not waited for. Returns NULL when the stage cannot
+/// be opened.
+usdinterop_stage_t *usdinterop_stage_open(const char *path, USDInteropLoadSet load_set);
+
+/// Opens a stage populated only with the given prim subtrees (and their
+/// ancestors), so composition cost tracks what the caller needs. A cached,
+/// fully populated stage for the same file is reused when present.
+usdinterop_stage_t *usdinterop_stage_open_masked(
+    const char *path,
+    USDInteropLoadSet load_set,
+    const char *const *prim_paths,
+    size_t prim_path_count
+);
+
+/// Adds a reference to a stage handle and returns it.
+usdinterop_stage_t *usdinterop_stage_retain(usdinterop_stage_t *stage);
+
+/// Drops a reference to a stage handle. The stage stays alive while any
+/// handle references it, even after the cache evicts it.
+void usdinterop_stage_release(usdinterop_stage_t *stage);
+
+/// Reloads the layers used by the stage whose files changed on disk since
+/// they were loaded; composition updates incrementally. Layers with unsaved
+/// edits are skipped. Returns the number of layers reloaded, -1 on failure
+/// (the layers are retried on the next refresh or open), or -2 when called
+/// from inside a query on the same thread, where reloading would deadlock.
+///
+/// Reloading changes layers for every stage in the process that shares them.
+/// It waits for C API queries to finish, but not for readers outside this
+/// API, such as traversals of stages opened through `USDInteropOpenUSDShim`;
+/// callers must not refresh while such readers may be running.
+int usdinterop_stage_refresh(usdinterop_stage_t *stage);
+
+/// Sets how many stages the cache keeps composed. Zero disables caching.
+void usdinterop_stage_cache_set_capacity(size_t capacity);
+
+/// Drops every stage pinned by the cache. Outstanding handles stay valid.
+void usdinterop_stage_cache_clear(void);
+
 const char *usdinterop_export_usda(const char *path);
 const char *usdinterop_scene_graph_json(const char *path);
 void usdinterop_free_string(const char *value);
 
+const char *usdinterop_export_usda_for_stage(const usdinterop_stage_t *stage);
+const char *usdinterop_scene_graph_json_for_stage(const usdinterop_stage_t *stage);
+
+/// Receives one chunk of streamed output. Return 0 to continue or nonzero to
+/// abort the write.
+typedef int (*usdinterop_write_fn)(const char *data, size_t size, void *context);
+
+/// Streams the scene graph JSON to `sink` in fixed-size chunks without
+/// materializing the whole document. Returns 1 on success, otherwise 0.
+int usdinterop_scene_graph_json_write(
+    const usdinterop_stage_t *stage,
+    usdinterop_write_fn sink,
+    void *context
+);
+
+/// Streams the scene graph JSON straight to an open file descriptor.
+/// Returns 1 on success, otherwise 0.
+int usdinterop_scene_graph_json_write_fd(const usdinterop_stage_t *stage, int fd);
+
+/// Returns one page of the children of `prim_path` as JSON:
+/// `{"path","childCount","offset","children":[...]}`. Children are expanded
+/// `depth` levels deep and every node reports its `childCount`; `limit` caps
+/// the page and each nested level (0 = no limit). The path-based variant
+/// pages off the file's cached stage, so repeated expansions compose once;
+/// use `usdinterop_stage_open_masked` explicitly to compose only a subtree.
+const char *usdinterop_scene_graph_children_json(
+    const char *path,
+    const char *prim_path,
+    int depth,
+    size_t offset,
+    size_t limit
+);
+const char *usdinterop_scene_graph_children_json_for_stage(
+    const usdinterop_stage_t *stage,
+    const char *prim_path,
+    int depth,
+    size_t offset,
+    size_t limit
+);
+
+/// Returns the prim hierarchy as one malloc block laid out as described by
+/// `USDInteropSceneGraphBinaryHeader`, freed with `usdinterop_free_bytes`.
+/// Consumers can walk it without parsing. Stores the block size in `size`.
+const void *usdinterop_scene_graph_binary(const char *path, size_t *size);
+const void *usdinterop_scene_graph_binary_for_stage(
+    const usdinterop_stage_t *stage,
+    size_t *size
+);
+
 /// Get scene bounds by iterating mesh points
 USDInteropBounds usdinterop_scene_bounds(const char *path);
 
+/// Computes the default prim's world bounds on an already composed stage.
+USDInteropBounds usdinterop_scene_bounds_for_stage(const usdinterop_stage_t *stage);
+
+/// Computes the default prim's world bounds without loading payloads.
+/// Uses `extentsHint` on models and authored `extent` on boundables, computes
+/// extents from geometry only where none is authored, and loads a payload
+/// only for unloaded subtrees that carry no hint or extent. Such payloads
+/// load on a separate masked stage with the same session layer, outside the
+/// stage cache. Invisible subtrees and proxy or guide prims are skipped.
+USDInteropFastBounds usdinterop_scene_bounds_fast(const char *path);
+USDInteropFastBounds usdinterop_scene_bounds_fast_for_stage(const usdinterop_stage_t *stage);
+
+/// One bounded subtree in a fast bounds result.
+typedef struct {
+    const char *primPath;
+    /// The single `USDINTEROP_BOUNDS_*` strategy that bounded this subtree.
+    int strategy;
+    /// World-space min xyz then max xyz; `min > max` when empty.
+    float range[6];
+} USDInteropBoundContribution;
+
+/// A fast bounds result plus the strategy and range of each contributing
+/// subtree, in traversal order (loaded payloads last). Free with
+/// `usdinterop_free_fast_bounds_detail`.
+typedef struct {
+    USDInteropFastBounds summary;
+    size_t contributionCount;
+    USDInteropBoundContribution *contributions;
+} USDInteropFastBoundsDetail;
+
+/// Like `usdinterop_scene_bounds_fast_for_stage`, also reporting which
+/// strategy produced each bound. Returns a zeroed result on failure.
+USDInteropFastBoundsDetail usdinterop_scene_bounds_fast_detail_for_stage(
+    const usdinterop_stage_t *stage
+);
+
+void usdinterop_free_fast_bounds_detail(USDInteropFastBoundsDetail detail);
+
+/// Computes world bounds for `prim_count` prims at `time_count` time codes.
+/// `out_bounds` receives 6 floats (min xyz, max xyz) per pair, time-major:
+/// entry `(t * prim_count + p) * 6`. Missing prims and empty bounds are
+/// written as min = FLT_MAX, max = -FLT_MAX. A NULL `time_codes` computes a
+/// single sample at the default time code. (time, prim) pairs are computed
+/// in parallel, each task reusing one bbox cache per time code it covers.
+/// Returns the number of non-empty bounds, or -1 on invalid arguments.
+int usdinterop_compute_bounds_batch(
+    const usdinterop_stage_t *stage,
+    const char *const *prim_paths,
+    size_t prim_count,
+    const double *time_codes,
+    size_t time_count,
+    float *out_bounds
+);
+
 /// Returns a strength-ordered list of authored source sites for a prim in the stage.
 USDInteropSourceSiteList usdinterop_stage_prim_source_sites(
     const char *stage_path,
@@ -49,9 +254,63 @@ USDInteropSourceSiteList usdinterop_stage_property_source_sites(
     const char *property_path
 );
 
+/// Handle-based variant of `usdinterop_stage_prim_source_sites`.
+USDInteropSourceSiteList usdinterop_prim_source_sites_for_stage(
+    const usdinterop_stage_t *stage,
+    const char *prim_path
+);
+
+/// Handle-based variant of `usdinterop_stage_property_source_sites`.
+USDInteropSourceSiteList usdinterop_property_source_sites_for_stage(
+    const usdinterop_stage_t *stage,
+    const char *property_path
+);
+
 /// Frees the strings and backing array returned in a source site list.
 void usdinterop_free_source_site_list(USDInteropSourceSiteList list);
 
+/// A layer contributing to a `USDInteropSourceSiteBatch`, listed once no
+/// matter how many sites it holds.
+typedef struct {
+    const char *identifier;
+    /// NULL for layers without a file, such as anonymous layers.
+    const char *realPath;
+} USDInteropSourceLayer;
+
+/// One authored opinion in a `USDInteropSourceSiteBatch`. `role` and `kind`
+/// match `USDInteropSourceSite`.
+typedef struct {
+    uint32_t layerIndex;
+    int role;
+    int kind;
+    const char *specPath;
+} USDInteropSourceSiteEntry;
+
+/// Source sites for many paths, strength-ordered per path. The sites of path
+/// `i` are `sites[firstSites[i]]` through
+/// `sites[firstSites[i] + siteCounts[i] - 1]`. Every array and string shares
+/// one allocation; free with `usdinterop_free_source_site_batch`.
+typedef struct {
+    size_t pathCount;
+    size_t siteCount;
+    size_t layerCount;
+    size_t *firstSites;
+    size_t *siteCounts;
+    USDInteropSourceSiteEntry *sites;
+    USDInteropSourceLayer *layers;
+} USDInteropSourceSiteBatch;
+
+/// Returns source sites for each of `paths`, which may mix prim and property
+/// paths. Paths that are invalid or not on the stage get no sites. Returns a
+/// zeroed batch on failure.
+USDInteropSourceSiteBatch usdinterop_source_sites_batch(
+    const usdinterop_stage_t *stage,
+    const char *const *paths,
+    size_t path_count
+);
+
+void usdinterop_free_source_site_batch(USDInteropSourceSiteBatch batch);
+
 /// Force OpenUSD to scan/register plugins under `path`.
 /// Returns the number of plugins registered by this call.
 int usdinterop_register_plugins(const char *path);
@@ -89,6 +348,347 @@ const unsigned char *usdinterop_read_asset_bytes(
 /// Frees a buffer returned by `usdinterop_read_asset_bytes`.
 void usdinterop_free_bytes(const void *value);
 
+/// Opaque handle to an asset opened through the Ar resolver.
+typedef struct usdinterop_asset_s usdinterop_asset_t;
+
+/// Resolves and opens an asset without reading it. `anchor_asset_path` is
+/// optional, as for `usdinterop_read_asset_bytes`. Returns NULL when the
+/// asset cannot be resolved or opened. Close with `usdinterop_asset_close`.
+usdinterop_asset_t *usdinterop_asset_open(const char *asset_path, const char *anchor_asset_path);
+
+/// Returns the asset's size in bytes.
+size_t usdinterop_asset_size(const usdinterop_asset_t *asset);
+
+/// Returns the asset's contents without copying. The pointer is memory-mapped
+/// for filesystem files and stored USDZ entries, and stays valid until the
+/// handle is closed. Returns NULL if the contents cannot be buffered.
+const void *usdinterop_asset_data(usdinterop_asset_t *asset);
+
+/// Copies up to `length` bytes starting at `offset` into `dst` and returns
+/// the number of bytes copied. Only the requested range is read, so headers
+/// can be sniffed without pulling a whole USDZ entry into memory.
+size_t usdinterop_asset_read_range(usdinterop_asset_t *asset, size_t offset, size_t length, void *dst);
+
+/// Reads the next chunk, up to `capacity` bytes, into `dst` and advances the
+/// handle's read position. Returns 0 at the end of the asset.
+size_t usdinterop_asset_read_next(usdinterop_asset_t *asset, void *dst, size_t capacity);
+
+/// Moves the position used by `usdinterop_asset_read_next`.
+void usdinterop_asset_seek(usdinterop_asset_t *asset, size_t offset);
+
+/// Returns the position used by `usdinterop_asset_read_next`.
+size_t usdinterop_asset_tell(const usdinterop_asset_t *asset);
+
+/// Closes an asset handle and releases its buffer.
+void usdinterop_asset_close(usdinterop_asset_t *asset);
+
+/// Outcome of one entry in `usdinterop_asset_open_batch`.
+typedef enum {
+    USDINTEROP_ASSET_OK = 0,
+    USDINTEROP_ASSET_UNRESOLVED = 1,
+    USDINTEROP_ASSET_OPEN_FAILED = 2,
+    USDINTEROP_ASSET_READ_FAILED = 3
+} USDInteropAssetStatus;
+
+typedef struct {
+    USDInteropAssetStatus status;
+    /// Open, already-buffered handle when `status` is OK; NULL otherwise.
+    /// Close with `usdinterop_asset_close`.
+    usdinterop_asset_t *asset;
+} USDInteropAssetBatchItem;
+
+/// Resolves `asset_paths` against one optional anchor and opens and buffers
+/// them concurrently, writing one item per path into `results`. With an
+/// anchor, the resolver context is created once and resolution is cached for
+/// the batch; without one, each path is resolved under its own default
+/// context, as `usdinterop_asset_open` would. Returns the number of assets
+/// opened.
+int usdinterop_asset_open_batch(
+    const char *anchor_asset_path,
+    const char *const *asset_paths,
+    size_t asset_count,
+    USDInteropAssetBatchItem *results
+);
+
+/// Resolves `asset_paths` against one optional anchor. With an anchor, every
+/// path is resolved under one resolver context binding and scoped resolver
+/// cache; without one, each path gets its own default context. Entry `i` of the result is the
+/// resolved path for `asset_paths[i]`, or NULL when it does not resolve.
+USDInteropStringList usdinterop_resolve_batch(
+    const char *anchor_asset_path,
+    const char *const *asset_paths,
+    size_t asset_count
+);
+
+/// Frees a list returned by `usdinterop_resolve_batch` or
+/// `usdinterop_prim_index_query`.
+void usdinterop_free_string_list(USDInteropStringList list);
+
+/// Element type of an array view. Vector, quaternion and matrix types are
+/// tightly packed float, double or int components.
+typedef enum {
+    USDINTEROP_ARRAY_UNSUPPORTED = 0,
+    USDINTEROP_ARRAY_BOOL = 1,
+    USDINTEROP_ARRAY_UCHAR = 2,
+    USDINTEROP_ARRAY_INT = 3,
+    USDINTEROP_ARRAY_UINT = 4,
+    USDINTEROP_ARRAY_INT64 = 5,
+    USDINTEROP_ARRAY_UINT64 = 6,
+    USDINTEROP_ARRAY_HALF = 7,
+    USDINTEROP_ARRAY_FLOAT = 8,
+    USDINTEROP_ARRAY_DOUBLE = 9,
+    USDINTEROP_ARRAY_VEC2I = 10,
+    USDINTEROP_ARRAY_VEC3I = 11,
+    USDINTEROP_ARRAY_VEC4I = 12,
+    USDINTEROP_ARRAY_VEC2F = 13,
+    USDINTEROP_ARRAY_VEC3F = 14,
+    USDINTEROP_ARRAY_VEC4F = 15,
+    USDINTEROP_ARRAY_VEC2D = 16,
+    USDINTEROP_ARRAY_VEC3D = 17,
+    USDINTEROP_ARRAY_VEC4D = 18,
+    USDINTEROP_ARRAY_QUATF = 19,
+    USDINTEROP_ARRAY_QUATD = 20,
+    USDINTEROP_ARRAY_MATRIX4D = 21
+} USDInteropArrayType;
+
+/// Opaque, reference-counted handle that keeps an attribute's `VtArray`
+/// alive. The array's storage is shared with OpenUSD, not copied.
+typedef struct usdinterop_array_s usdinterop_array_t;
+
+/// Read-only view of an array handle's elements, valid until the handle is
+/// released. `elementSize` is in bytes.
+typedef struct {
+    const void *data;
+    size_t count;
+    size_t elementSize;
+    USDInteropArrayType type;
+} USDInteropArrayView;
+
+/// Reads an array-valued attribute such as `/Mesh.points`, `/Mesh.normals`
+/// or `/Mesh.faceVertexIndices` at `*time_code`, or at the default time when
+/// `time_code` is NULL. Returns NULL when the attribute is missing, has no
+/// value, or holds a non-numeric array such as tokens or strings.
+usdinterop_array_t *usdinterop_attribute_array_open(
+    const usdinterop_stage_t *stage,
+    const char *attribute_path,
+    const double *time_code
+);
+
+/// Reads the primvar `primvar_name` (without the `primvars:` prefix) on a
+/// prim. For indexed primvars the values are returned unflattened and
+/// `indices`, when not NULL, receives a handle to the index array; it is set
+/// to NULL for non-indexed primvars.
+usdinterop_array_t *usdinterop_primvar_array_open(
+    const usdinterop_stage_t *stage,
+    const char *prim_path,
+    const char *primvar_name,
+    const double *time_code,
+    usdinterop_array_t **indices
+);
+
+USDInteropArrayView usdinterop_array_view(const usdinterop_array_t *array);
+
+/// Copies up to `count` elements starting at element `first` into `dst`,
+/// for callers that need to own the data. Returns the number copied.
+size_t usdinterop_array_copy(
+    const usdinterop_array_t *array,
+    size_t first,
+    size_t count,
+    void *dst
+);
+
+/// Adds a reference to an array handle and returns it.
+usdinterop_array_t *usdinterop_array_retain(usdinterop_array_t *array);
+
+/// Drops a reference to an array handle.
+void usdinterop_array_release(usdinterop_array_t *array);
+
+/// Per-mesh flags in `USDInteropMeshRange` (bit flags).
+enum {
+    USDINTEROP_MESH_COMPUTED_NORMALS = 1 << 0,
+    USDINTEROP_MESH_HAS_UVS = 1 << 1,
+    USDINTEROP_MESH_FACE_VARYING = 1 << 2
+};
+
+/// One mesh in `USDInteropMeshBuffers`. Its vertices are
+/// `[firstVertex, firstVertex + vertexCount)` and its triangles are
+/// `[firstIndex, firstIndex + indexCount)`; indices are relative to
+/// `firstVertex`. `flags` is a bitwise OR of the flags above.
+typedef struct {
+    const char *primPath;
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int flags;
+} USDInteropMeshRange;
+
+/// Render-ready triangle meshes packed into one allocation. Positions and
+/// normals are world space, 3 floats per vertex; `uvs` holds 2 floats per
+/// vertex and is zero for meshes without an `st` primvar. Triangles are
+/// counter-clockwise. Freed with `usdinterop_free_mesh_buffers`.
+typedef struct {
+    size_t meshCount;
+    size_t vertexCount;
+    size_t indexCount;
+    USDInteropMeshRange *meshes;
+    float *positions;
+    float *normals;
+    float *uvs;
+    uint32_t *indices;
+} USDInteropMeshBuffers;
+
+/// Extracts every visible, renderable mesh under `root_prim_path` (the whole
+/// stage when NULL or empty) at `*time_code`, or the default time when
+/// `time_code` is NULL. Meshes are triangulated, transformed to world space
+/// and given smooth normals where none are authored, in parallel. Meshes
+/// whose normals or UVs vary per face-vertex get one vertex per face-vertex.
+/// Meshes are listed in traversal order. Returns empty buffers on failure.
+USDInteropMeshBuffers usdinterop_extract_meshes(
+    const usdinterop_stage_t *stage,
+    const char *root_prim_path,
+    const double *time_code
+);
+
+/// Frees buffers returned by `usdinterop_extract_meshes`.
+void usdinterop_free_mesh_buffers(USDInteropMeshBuffers buffers);
+
+/// Dense attribute samples from `usdinterop_sample_attributes`, in one
+/// allocation freed with `usdinterop_free_attribute_samples`. Each attribute
+/// is a column: its sample at frame `f` is the `componentCounts[a]` doubles
+/// starting at `values[columnOffsets[a] + f * componentCounts[a]]`. Scalars
+/// have one component, vectors their dimension, quaternions four (imaginary
+/// then real) and matrices their elements in row order. Frames where an
+/// attribute has no value hold NaN.
+typedef struct {
+    size_t attributeCount;
+    size_t frameCount;
+    /// `frameCount` sample times.
+    double *times;
+    double *values;
+    size_t *columnOffsets;
+    /// 0 for attributes that are missing or not numeric; such attributes
+    /// have an empty column.
+    uint32_t *componentCounts;
+} USDInteropAttributeSamples;
+
+/// Samples attributes at `start_time`, `start_time + stride`, ... up to and
+/// including `end_time`. Each attribute is looked up and given a
+/// `UsdAttributeQuery` once; samples are then read in parallel without
+/// per-sample allocation. A non-positive stride samples `start_time` only.
+/// Returns zeroed samples on failure, including non-finite times or strides
+/// and ranges of more than 2^24 frames.
+USDInteropAttributeSamples usdinterop_sample_attributes(
+    const usdinterop_stage_t *stage,
+    const char *const *attribute_paths,
+    size_t attribute_count,
+    double start_time,
+    double end_time,
+    double stride
+);
+
+/// Frees samples returned by `usdinterop_sample_attributes`.
+void usdinterop_free_attribute_samples(USDInteropAttributeSamples samples);
+
+typedef struct {
+    const char *typeName;  // empty for untyped prims
+    uint64_t count;
+} USDInteropPrimTypeCount;
+
+/// Whole-stage statistics in one allocation, freed with
+/// `usdinterop_free_stage_statistics`. Counts cover the prims visited by a
+/// default traversal plus, with `USDINTEROP_STATISTICS_PROTOTYPES`, the prims
+/// inside instancing prototypes, so each prototype's meshes are counted once
+/// however many instances use it. Fields whose option was not requested are
+/// zero.
+typedef struct USDInteropStageStatistics {
+    uint64_t primCount;
+    uint64_t meshCount;
+    uint64_t meshPointCount;
+    uint64_t meshFaceCount;
+    uint64_t meshFaceVertexCount;
+    /// Authored primvars on meshes.
+    uint64_t meshPrimvarCount;
+    uint64_t materialCount;
+    uint64_t instanceCount;
+    uint64_t prototypeCount;
+    uint64_t layerCount;
+    /// Sum of the on-disk sizes of the stage's used layers, as a proxy for
+    /// the memory they take; anonymous layers contribute nothing.
+    uint64_t layerByteEstimate;
+    /// Prim counts by type name, most common first.
+    size_t typeCountCount;
+    USDInteropPrimTypeCount *typeCounts;
+    /// Prims typed exactly `Camera`.
+    size_t cameraCount;
+    const char **cameraPaths;
+    /// Prims typed `SkelAnimation`, `Animation` or `RealityKitTimeline`.
+    size_t animationCount;
+    const char **animationPaths;
+} USDInteropStageStatistics;
+
+/// Optional parts of `usdinterop_stage_statistics_with_options`. Prim and
+/// type counts, instance counts and camera and animation paths are always
+/// computed; with no options that is all the traversal does (bit flags).
+enum {
+    /// Mesh and material totals. Reads every mesh's points and face counts.
+    USDINTEROP_STATISTICS_MESHES = 1 << 0,
+    /// Also traverse instancing prototypes, and fill `prototypeCount`.
+    USDINTEROP_STATISTICS_PROTOTYPES = 1 << 1,
+    /// `layerCount` and `layerByteEstimate`. Opens every used layer's asset.
+    USDINTEROP_STATISTICS_LAYERS = 1 << 2,
+    USDINTEROP_STATISTICS_ALL = (1 << 3) - 1
+};
+
+/// Traverses the stage once, splitting it into subtrees that are traversed
+/// and analysed in parallel. Computes everything, like
+/// `usdinterop_stage_statistics_with_options` with
+/// `USDINTEROP_STATISTICS_ALL`. Returns NULL on failure.
+USDInteropStageStatistics *usdinterop_stage_statistics(const usdinterop_stage_t *stage);
+
+/// `usdinterop_stage_statistics` limited to the parts in `options`, a bitwise
+/// OR of the flags above.
+USDInteropStageStatistics *usdinterop_stage_statistics_with_options(
+    const usdinterop_stage_t *stage,
+    uint32_t options);
+
+void usdinterop_free_stage_statistics(USDInteropStageStatistics *statistics);
+
+/// Opaque index of a stage's prims by type, kind, applied API schema and
+/// name. It listens for stage changes and reindexes only resynced subtrees,
+/// so it stays current across edits, payload loads and
+/// `usdinterop_stage_refresh`.
+typedef struct usdinterop_prim_index_s usdinterop_prim_index_t;
+
+/// What `usdinterop_prim_index_query` matches `value` against.
+typedef enum {
+    /// Schema type name, such as "Camera". Derived types match too, so
+    /// "Gprim" finds meshes, spheres and so on.
+    USDINTEROP_PRIM_INDEX_TYPE = 0,
+    /// Model kind, such as "component". Exact match.
+    USDINTEROP_PRIM_INDEX_KIND = 1,
+    /// Applied API schema name, such as "MaterialBindingAPI". Exact match.
+    USDINTEROP_PRIM_INDEX_API_SCHEMA = 2,
+    /// Case-insensitive ASCII prefix of the prim name.
+    USDINTEROP_PRIM_INDEX_NAME_PREFIX = 3
+} USDInteropPrimIndexKey;
+
+/// Indexes the active, loaded, defined prims of a stage. The index keeps its
+/// own reference to the stage. Returns NULL on failure.
+usdinterop_prim_index_t *usdinterop_prim_index_create(usdinterop_stage_t *stage);
+
+void usdinterop_prim_index_destroy(usdinterop_prim_index_t *index);
+
+/// Returns the paths of matching prims in path order, at most `limit` of
+/// them (0 = no limit), packed in one allocation. Free with
+/// `usdinterop_free_string_list`.
+USDInteropStringList usdinterop_prim_index_query(
+    usdinterop_prim_index_t *index,
+    USDInteropPrimIndexKey key,
+    const char *value,
+    size_t limit
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,11 +27,15 @@
 #include "pxr/usd/usdUtils/api.h"
 #include "pxr/usd/usdUtils/dependencies.h"
 #include "pxr/usd/usdUtils/usdzPackage.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+// Declared in USDInteropCxx.h, which includes this header first.
+struct USDInteropStageStatistics;
+
 /// Result struct for dependency checking - Swift friendly
 struct DependencyCheckResultCxx {
   bool success;
@@ -46,6 +50,22 @@ struct UsdzPackagingResultCxx {
   int failedAssetCount;
 };
 
+/// Dependency check result that owns its unresolved paths, so concurrent
+/// checks on different threads never share state.
+struct DependencyCheckReportCxx {
+  bool success;
+  std::vector<std::string> unresolvedPaths;
+
+  int GetUnresolvedCount() const;
+
+  /// Returns empty string if index out of bounds
+  std::string GetUnresolvedPath(int index) const;
+};
+
+/// Checks dependencies and returns every unresolved path with the result.
+/// Safe to call from several threads at once.
+DependencyCheckReportCxx CheckDependenciesReport(const std::string &assetPath);
+
 /// Check dependencies and return result struct
 DependencyCheckResultCxx CheckDependenciesSimple(const std::string &assetPath);
 
@@ -56,6 +76,106 @@ std::string GetUnresolvedPath(int index);
 /// Clear cached unresolved paths
 void ClearUnresolvedCache();
 
+/// `CheckDependenciesSimple` caches each layer's direct dependencies and only
+/// re-scans layers whose size or modification time changed. Setting a file
+/// loads previously saved edges and keeps the file updated after each check,
+/// so warm checks survive restarts. Pass an empty path for an in-memory cache.
+bool SetDependencyCacheFile(const std::string &path);
+
+/// Drops every cached dependency edge.
+void ClearDependencyCache();
+
+/// Kind of a dependency in `DependencyAuditReportCxx::dependencies`.
+enum DependencyKindCxx : int {
+  DependencyKindLayer = 0,
+  DependencyKindAsset = 1,
+  DependencyKindUnresolved = 2,
+};
+
+/// One distinct dependency seen by an audit. Resolved dependencies are keyed
+/// by resolved path, unresolved ones by anchored asset path.
+struct DependencyAuditDependencyCxx {
+  std::string path;
+  int kind;
+  /// Number of audited assets that depend on it, directly or not.
+  int assetCount;
+};
+
+/// Audit result for one root asset. Indices refer to
+/// `DependencyAuditReportCxx::dependencies`; the asset's own root layer is
+/// not listed.
+struct DependencyAuditAssetCxx {
+  std::string assetPath;
+  bool success;
+  std::vector<int> dependencyIndices;
+  std::vector<int> unresolvedIndices;
+};
+
+/// Result of `AuditDependencies`: one entry per audited asset, in input
+/// order, plus every distinct dependency across all of them.
+struct DependencyAuditReportCxx {
+  std::vector<DependencyAuditAssetCxx> assets;
+  std::vector<DependencyAuditDependencyCxx> dependencies;
+
+  /// Number of assets with a missing root or unresolved dependency.
+  int GetFailedAssetCount() const;
+
+  /// Returns empty string if either index is out of bounds
+  std::string GetUnresolvedPath(int assetIndex, int index) const;
+};
+
+using DependencyAuditPathListCxx = std::vector<std::string>;
+
+/// Checks many assets at once across the work thread pool. Each layer shared
+/// between assets is scanned once through the dependency cache, and the
+/// cache is saved once at the end. Equivalent to calling
+/// `CheckDependenciesSimple` on each path, much faster for large libraries.
+DependencyAuditReportCxx
+AuditDependencies(const std::vector<std::string> &assetPaths);
+
+/// Audits every .usd, .usda, .usdc and .usdz file below `directory`, in
+/// path order.
+DependencyAuditReportCxx
+AuditDependenciesInDirectory(const std::string &directory);
+
+/// One diagnostic in `PackagingDiagnosticsCxx`. Severity is 0 for status,
+/// 1 for warnings, 2 for errors and 3 for fatal errors.
+struct PackagingDiagnosticRecordCxx {
+  int severity;
+  uint32_t messageOffset;
+  uint32_t messageLength;
+};
+
+/// Every diagnostic and failed asset path from one packaging call in one
+/// block. Messages and paths live NUL-terminated in `text`; records and
+/// `failedAssetPathOffsets` index into it.
+struct PackagingDiagnosticsCxx {
+  std::vector<PackagingDiagnosticRecordCxx> diagnostics;
+  std::vector<uint32_t> failedAssetPathOffsets;
+  std::string text;
+
+  int GetDiagnosticCount() const;
+  std::string GetMessage(int index) const;
+  /// Returns -1 if index out of bounds
+  int GetSeverity(int index) const;
+  int GetFailedAssetCount() const;
+  std::string GetFailedAssetPath(int index) const;
+};
+
+/// Packaging result that carries its own diagnostics. The `*Report`
+/// packaging functions return one per call and leave the `GetPackaging*`
+/// accessors untouched, so packages can be built concurrently.
+struct UsdzPackagingReportCxx {
+  UsdzPackagingResultCxx summary;
+  PackagingDiagnosticsCxx diagnostics;
+  /// Entries copied from the previous package by
+  /// `UpdateUsdzPackageIncrementalReport`; 0 for every other call.
+  int reusedEntries;
+  int64_t reusedBytes;
+};
+
+
+
 /// Creates a USDZ package using the current native OpenUSD API.
 ///
 /// This always uses `UsdUtilsCreateNewUsdzPackage`, which preserves authored
@@ -71,6 +191,90 @@ UsdzPackagingResultCxx CreateUsdzPackageNativeDetailed(
     const std::string &assetPath,
     const std::string &outputPath);
 
+/// `CreateUsdzPackageNativeDetailed` without touching the per-thread
+/// diagnostic cache. Errors raised during the call are kept, including those
+/// Work threads hand back to the caller, as are warnings and status messages
+/// issued on the calling thread. Warnings UsdUtils issues on Work threads are
+/// not captured, so concurrent calls never see each other's messages.
+UsdzPackagingReportCxx CreateUsdzPackageNativeReport(
+    const std::string &assetPath,
+    const std::string &outputPath);
+
+/// Phases reported while packaging. Reading and writing overlap, so both are
+/// reported as `UsdzPackagingStageWriting`.
+enum UsdzPackagingStageCxx : int {
+  UsdzPackagingStageDiscovering = 0,
+  UsdzPackagingStageWriting = 1,
+  UsdzPackagingStageFinished = 2,
+};
+
+/// Progress snapshot passed to a packaging callback. Timings are wall-clock
+/// seconds, except `readSeconds`, which sums time spent across reader threads.
+struct UsdzPackagingProgressCxx {
+  int stage;
+  int completedEntries;
+  int totalEntries;
+  int64_t completedBytes;
+  int64_t totalBytes;
+  /// Entries copied from the previous package by `UpdateUsdzPackageIncremental`.
+  int reusedEntries;
+  int64_t reusedBytes;
+  double discoverySeconds;
+  double readSeconds;
+  double writeSeconds;
+};
+
+/// Called on the packaging thread after discovery, after each written entry
+/// and once when packaging finishes.
+typedef void (*UsdzPackagingProgressCallback)(
+    const UsdzPackagingProgressCxx &progress, void *context);
+
+/// Creates a USDZ package by reading dependencies in parallel while a single
+/// writer streams them into the archive in order, 64-byte aligned. Layers
+/// are copied byte for byte, so authored metadata is preserved as with
+/// `CreateUsdzPackageNativeDetailed`.
+///
+/// Packages whose dependencies need their asset paths rewritten (absolute
+/// paths, files outside the root layer's directory, files inside other
+/// packages, unsaved layers or unresolved references) are delegated to
+/// `CreateUsdzPackageNativeDetailed`, which reports no per-entry progress.
+/// Diagnostics are read back with the `GetPackaging*` accessors below.
+UsdzPackagingResultCxx CreateUsdzPackagePipelined(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context);
+
+/// Rebuilds the package at `outputPath` from `assetPath`, copying entries
+/// from the existing package byte for byte when they are unchanged. A source
+/// whose size, nanosecond modification time, inode and device match those
+/// recorded in the previous package is not read at all; any other source is
+/// read and its entry reused only when the size and CRC-32 match. Without a
+/// previous package this behaves like `CreateUsdzPackagePipelined`.
+UsdzPackagingResultCxx UpdateUsdzPackageIncremental(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context);
+
+/// Report-returning forms of the two functions above.
+UsdzPackagingReportCxx CreateUsdzPackagePipelinedReport(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context);
+
+UsdzPackagingReportCxx UpdateUsdzPackageIncrementalReport(
+    const std::string &assetPath,
+    const std::string &outputPath,
+    UsdzPackagingProgressCallback progress,
+    void *context);
+
+/// Returns all diagnostics from the last packaging call on this thread at
+/// once, instead of one string per call through the index-based accessors
+/// below.
+PackagingDiagnosticsCxx GetPackagingDiagnostics();
+
 std::string GetPackagingDiagnosticMessage(int index);
 
 int GetPackagingDiagnosticSeverity(int index);
@@ -92,6 +296,7 @@ using UsdAttribute = pxr::UsdAttribute;
 using SdfLayerHandle = pxr::SdfLayerHandle;
 using SdfLayerRefPtr = pxr::SdfLayerRefPtr;
 using SdfLayer = pxr::SdfLayer;
+using SdfLayerHandleVector = pxr::SdfLayerHandleVector;
 using UsdEditTarget = pxr::UsdEditTarget;
 using UsdVariantSets = pxr::UsdVariantSets;
 using UsdVariantSet = pxr::UsdVariantSet;
@@ -130,6 +335,24 @@ bool RewriteAttributeSpecTypeToString(const USD::SdfLayerHandle &layer,
 int RewriteAllTokenAttributeSpecsToString(const USD::SdfLayerHandle &layer,
                                           const std::string &propertyName);
 
+using PropertyNameListCxx = std::vector<std::string>;
+
+/// Rewrites every token attribute spec whose name is in `propertyNames`
+/// across `layers` in one pass. Each distinct layer is scanned once, in
+/// parallel, and all rewrites are applied under one `SdfChangeBlock`.
+/// Returns the number of specs rewritten, or the number that would be with
+/// `dryRun`.
+int RewriteTokenAttributeSpecsToString(
+    const USD::SdfLayerHandleVector &layers,
+    const std::vector<std::string> &propertyNames,
+    bool dryRun);
+
+/// Same as above over the stage's layer stack, session layers included.
+int RewriteTokenAttributeSpecsToString(
+    const USD::UsdStage &stage,
+    const std::vector<std::string> &propertyNames,
+    bool dryRun);
+
 /// Copies a spec from a ref-counted source layer into a destination layer
 /// handle. This lets C++ perform the ref->weak conversion that Swift interop
 /// does not expose directly.
@@ -175,6 +398,61 @@ bool SetAttributeToken(USD::UsdAttribute attr,
 
 bool BlockAttribute(USD::UsdAttribute attr);
 
+/// Value carried by an `AttributeEditCxx`.
+enum AttributeEditTypeCxx : int {
+  AttributeEditBool = 0,
+  AttributeEditInt = 1,
+  AttributeEditFloat = 2,
+  AttributeEditColor3f = 3,
+  AttributeEditString = 4,
+  AttributeEditToken = 5,
+  AttributeEditAssetPath = 6,
+  /// Authors a value block; the payload is ignored.
+  AttributeEditBlock = 7,
+};
+
+/// Per-record result of `ApplyAttributeEdits`.
+enum AttributeEditStatusCxx : uint8_t {
+  AttributeEditApplied = 0,
+  AttributeEditMissingAttribute = 1,
+  AttributeEditInvalidType = 2,
+  AttributeEditFailed = 3,
+};
+
+/// One tagged attribute edit. `type` selects the payload: `intValue` holds
+/// bools (non-zero is true) and ints, `floatValues` holds a float in its
+/// first element or a color, and `text` holds strings, tokens and asset paths.
+struct AttributeEditCxx {
+  USD::SdfPath attributePath;
+  int type;
+  int intValue;
+  float floatValues[3];
+  std::string text;
+  USD::UsdTimeCode timeCode;
+};
+
+using AttributeEditListCxx = std::vector<AttributeEditCxx>;
+
+/// Applies `edits` in order on the stage's current edit target inside one
+/// `SdfChangeBlock`, so the whole batch sends one change notice and
+/// recomposes once instead of once per `SetAttribute*` call. Attributes must
+/// already exist, and an edit whose value type differs from the attribute's
+/// (a color on a float attribute, say) is rejected as
+/// `AttributeEditInvalidType`; colors fit any float3-valued attribute.
+/// Returns one `AttributeEditStatusCxx` per edit; a failed edit does not
+/// stop the ones after it.
+std::vector<uint8_t> ApplyAttributeEdits(
+    const USD::UsdStage &stage,
+    const AttributeEditListCxx &edits);
+
+/// Starts counting the `UsdNotice::ObjectsChanged` notices `stage` sends, so
+/// callers can confirm that a batch of edits notified listeners once.
+/// Returns an id for `EndObjectsChangedCount`, or -1 on failure.
+int BeginObjectsChangedCount(const USD::UsdStage &stage);
+
+/// Stops the count started as `id` and returns it; -1 for an unknown id.
+int EndObjectsChangedCount(int id);
+
 bool DisconnectShadeInput(USD::UsdShadeInput input);
 
 USD::UsdShadeInput CreateShaderInput(USD::UsdShadeShader shader,
@@ -194,6 +472,11 @@ bool ConnectShadeInputToOutput(USD::UsdShadeInput input,
 bool ExportStage(const USD::UsdStage &stage,
                  const std::string &path,
                  bool addSourceFileComment);
+
+/// `usdinterop_stage_statistics_with_options` for a stage Swift already
+/// holds. Free the result with `usdinterop_free_stage_statistics`.
+USDInteropStageStatistics *GetStageStatistics(const USD::UsdStage &stage,
+                                              uint32_t options);
 }
 
 #endif
@@ -118,19 +118,11 @@ public struct USDOperationsClient: Sendable {
         metadata.startTimeCode = stage.GetStartTimeCode()
         metadata.endTimeCode = stage.GetEndTimeCode()
 
-        var animationTracks: [String] = []
-        var availableCameras: [String] = []
-        for prim in stage.Traverse() {
-            let typeName = String(prim.GetTypeName().GetString())
-            if typeName == "SkelAnimation" || typeName == "Animation" || typeName == "RealityKitTimeline" {
-                animationTracks.append(String(prim.GetPath().GetString()))
-            }
-            if typeName == "Camera" {
-                availableCameras.append(String(prim.GetPath().GetString()))
-            }
+        // Paths only: no mesh reads, prototype walk or layer sizing.
+        if let statistics = USDInteropOpenUSDShim.stageStatistics(stage, options: []) {
+            metadata.animationTracks = statistics.animationPaths
+            metadata.availableCameras = statistics.cameraPaths
         }
-        metadata.animationTracks = animationTracks
-        metadata.availableCameras = availableCameras
         return metadata
     }
 
@@ -263,6 +255,47 @@ public struct USDOperationsClient: Sendable {
         )
     }
 
+    /// Provenance for many prims from one stage open. Results line up with
+    /// `paths`.
+    public func primProvenance(url: URL, paths: [String]) -> [USDPrimProvenance?] {
+        batchSourceSites(url: url, paths: paths).enumerated().map { index, sites in
+            sites.isEmpty ? nil : USDPrimProvenance(primPath: paths[index], sites: sites)
+        }
+    }
+
+    /// Provenance for many properties from one stage open. Results line up
+    /// with `paths`.
+    public func propertyProvenance(url: URL, paths: [String]) -> [USDPropertyProvenance?] {
+        batchSourceSites(url: url, paths: paths).enumerated().map { index, sites in
+            guard sites.isEmpty == false else {
+                return nil
+            }
+            let path = paths[index]
+            return USDPropertyProvenance(
+                propertyPath: path,
+                primPath: propertyPrimPath(from: path),
+                sites: sites
+            )
+        }
+    }
+
+    private func batchSourceSites(url: URL, paths: [String]) -> [[USDSourceSite]] {
+        guard let stage = USDInteropStageHandle(url: url, loadSet: .all) else {
+            return Array(repeating: [], count: paths.count)
+        }
+        return stage.sourceSites(paths: paths).map { sites in
+            sites.map { site in
+                USDSourceSite(
+                    layerIdentifier: site.layerIdentifier,
+                    layerRealPath: site.layerRealPath,
+                    specPath: site.specPath,
+                    role: makeProvenanceRole(site.role),
+                    kind: makeProvenanceKind(site.kind)
+                )
+            }
+        }
+    }
+
     public func listVariantSets(url: URL, scope: USDVariantScope) throws -> [USDVariantSetDescriptor] {
         let stage = try openStage(url)
         let prim = try prim(for: scope, stage: stage)
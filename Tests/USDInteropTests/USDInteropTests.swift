@@ -1,6 +1,11 @@
+import CxxStdlib
 import Foundation
+import OpenUSD
 import Testing
 @testable import USDInterop
+import USDInteropCxx
+
+fileprivate typealias pxr = pxrInternal_v0_26_3__pxrReserved__
 
 @Test func builtInFileFormatsAreResolvable() {
     #expect(USDInteropPlugins.hasFileFormat("usd"))
@@ -43,3 +48,1303 @@ import Testing
             == "materials/textures/albedo.png"
     )
 }
+
+@Test func stageHandlesShareCachedStageAcrossQueries() throws {
+    let url = URL(filePath: NSTemporaryDirectory())
+        .appending(path: "usdinterop-stage-handle-\(UUID().uuidString).usda")
+    try """
+    #usda 1.0
+    (
+        defaultPrim = "Root"
+    )
+
+    def Xform "Root"
+    {
+        def Cube "Box"
+        {
+            double size = 2
+        }
+    }
+    """.write(to: url, atomically: true, encoding: .utf8)
+    defer { try? FileManager.default.removeItem(at: url) }
+
+    let first = try #require(USDInteropStageHandle(url: url))
+    let second = try #require(USDInteropStageHandle(url: url))
+    #expect(first.sceneGraphJSON() == second.sceneGraphJSON())
+    #expect(first.sceneGraphJSON() == USDInteropStage.sceneGraphJSON(url: url))
+
+    let bounds = try #require(second.sceneBounds())
+    #expect(bounds.maxExtent == 2)
+}
+
+@Test func reopeningAChangedFileReloadsLayersHeldByAnotherHandle() throws {
+    let url = try makeTemporaryStage("held", cubeLayer(size: 2))
+    defer { try? FileManager.default.removeItem(at: url) }
+
+    // The LOAD_NONE entry shares the root layer with the LOAD_ALL stage, so
+    // the layer registry keeps the old contents in memory across the edit.
+    let keeper = try #require(USDInteropStageHandle(url: url, loadSet: .none))
+    let first = try #require(USDInteropStageHandle(url: url))
+    #expect(first.sceneBounds()?.maxExtent == 2)
+
+    try cubeLayer(size: 30).write(to: url, atomically: true, encoding: .utf8)
+    let reopened = try #require(USDInteropStageHandle(url: url))
+    #expect(reopened.sceneBounds()?.maxExtent == 30)
+    #expect(first.sceneBounds()?.maxExtent == 30)
+
+    // The reload was recorded, so neither handle sees the edit again.
+    #expect(keeper.refresh() == 0)
+    #expect(first.refresh() == 0)
+
+    try cubeLayer(size: 4).write(to: url, atomically: true, encoding: .utf8)
+    #expect(keeper.refresh() == 1)
+    #expect(reopened.sceneBounds()?.maxExtent == 4)
+}
+
+private func makeTemporaryDirectory(_ name: String) throws -> URL {
+    let directory = URL(filePath: NSTemporaryDirectory())
+        .appending(path: "usdinterop-\(name)-\(UUID().uuidString)")
+    try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    return directory
+}
+
+private func cubeLayer(size: Int) -> String {
+    """
+    #usda 1.0
+    (
+        defaultPrim = "Box"
+    )
+
+    def Xform "Box"
+    {
+        def Cube "Geom"
+        {
+            double size = \(size)
+        }
+    }
+    """
+}
+
+@Test func incrementalPackagingReusesUnchangedEntries() throws {
+    let directory = try makeTemporaryDirectory("package")
+    defer { try? FileManager.default.removeItem(at: directory) }
+
+    let root = directory.appending(path: "root.usda")
+    let box = directory.appending(path: "box.usda")
+    let package = directory.appending(path: "root.usdz")
+    try """
+    #usda 1.0
+    (
+        defaultPrim = "Root"
+    )
+
+    def Xform "Root" (
+        references = @./box.usda@
+    )
+    {
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+    try cubeLayer(size: 2).write(to: box, atomically: true, encoding: .utf8)
+
+    let first = UpdateUsdzPackageIncrementalReport(
+        std.string(root.path), std.string(package.path), nil, nil
+    )
+    #expect(first.summary.success)
+    #expect(first.reusedEntries == 0)
+
+    let unchanged = UpdateUsdzPackageIncrementalReport(
+        std.string(root.path), std.string(package.path), nil, nil
+    )
+    #expect(unchanged.summary.success)
+    #expect(unchanged.reusedEntries == 2)
+
+    // Same size, but the atomic write gives the file a new inode, so its
+    // stamp no longer matches and the CRC tells the edited file apart.
+    try cubeLayer(size: 3).write(to: box, atomically: true, encoding: .utf8)
+    let edited = UpdateUsdzPackageIncrementalReport(
+        std.string(root.path), std.string(package.path), nil, nil
+    )
+    #expect(edited.summary.success)
+    #expect(edited.reusedEntries == 1)
+
+    let stage = try #require(USDInteropStageHandle(url: package))
+    let bounds = try #require(stage.sceneBounds())
+    #expect(bounds.maxExtent == 3)
+}
+
+@Test func incrementalPackagingDoesNotOpenSourcesWithMatchingStamps() throws {
+    let directory = try makeTemporaryDirectory("stamped")
+    defer { try? FileManager.default.removeItem(at: directory) }
+
+    let root = directory.appending(path: "root.usda")
+    let notes = directory.appending(path: "notes.txt")
+    let package = directory.appending(path: "root.usdz")
+    try """
+    #usda 1.0
+
+    def "Root"
+    {
+        asset notes = @./notes.txt@
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+    try "original notes".write(to: notes, atomically: true, encoding: .utf8)
+
+    // Stamps are only recorded for files last modified before the current
+    // second, so backdate both sources.
+    let settled = Date(timeIntervalSince1970: 1_600_000_000)
+    for url in [root, notes] {
+        try FileManager.default.setAttributes(
+            [.modificationDate: settled], ofItemAtPath: url.path
+        )
+    }
+    let first = UpdateUsdzPackageIncrementalReport(
+        std.string(root.path), std.string(package.path), nil, nil
+    )
+    #expect(first.summary.success)
+
+    // Rewrite the contents in place, keeping the size, inode and mtime. Only
+    // a rebuild that never opens the source keeps the original bytes.
+    let handle = try FileHandle(forWritingTo: notes)
+    try handle.write(contentsOf: Data("replaced notes".utf8))
+    try handle.close()
+    try FileManager.default.setAttributes(
+        [.modificationDate: settled], ofItemAtPath: notes.path
+    )
+
+    let second = UpdateUsdzPackageIncrementalReport(
+        std.string(root.path), std.string(package.path), nil, nil
+    )
+    #expect(second.summary.success)
+    #expect(second.reusedEntries == 2)
+    let archive = try Data(contentsOf: package)
+    #expect(archive.range(of: Data("original notes".utf8)) != nil)
+    #expect(archive.range(of: Data("replaced notes".utf8)) == nil)
+}
+
+private func packagingMessages(_ report: UsdzPackagingReportCxx) -> [String] {
+    (0..<report.diagnostics.GetDiagnosticCount()).map {
+        String(report.diagnostics.GetMessage($0))
+    }
+}
+
+/// Results written by concurrent iterations, one slot each.
+private final class ConcurrentResults<Value>: @unchecked Sendable {
+    private let lock = NSLock()
+    private var values: [Int: Value] = [:]
+
+    subscript(index: Int) -> Value? {
+        get { lock.withLock { values[index] } }
+        set { lock.withLock { values[index] = newValue } }
+    }
+}
+
+@Test func concurrentPackagingCallsKeepTheirOwnDiagnostics() throws {
+    let directory = try makeTemporaryDirectory("concurrent")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let clean = directory.appending(path: "clean.usda")
+    let broken = directory.appending(path: "broken.usda")
+    try cubeLayer(size: 2).write(to: clean, atomically: true, encoding: .utf8)
+    try """
+    #usda 1.0
+
+    def Shader "Texture"
+    {
+        asset inputs:file = @./missing.png@
+    }
+    """.write(to: broken, atomically: true, encoding: .utf8)
+
+    let sources = [clean, broken]
+    let package = { (source: Int, output: String) -> [String] in
+        let report = CreateUsdzPackageNativeReport(
+            std.string(sources[source].path),
+            std.string(directory.appending(path: output).path)
+        )
+        return packagingMessages(report)
+    }
+    let serial = [package(0, "serial-0.usdz"), package(1, "serial-1.usdz")]
+    #expect(!serial[0].contains { $0.contains("missing.png") })
+
+    // Each report holds exactly what the same call reports on its own,
+    // whatever runs beside it.
+    let results = ConcurrentResults<[String]>()
+    DispatchQueue.concurrentPerform(iterations: 8) { iteration in
+        results[iteration] = package(iteration % 2, "concurrent-\(iteration).usdz")
+    }
+    for iteration in 0..<8 {
+        #expect(results[iteration] == serial[iteration % 2])
+    }
+}
+
+/// Checks that every record and failed asset path points at a
+/// NUL-terminated string in `text` that the accessors return unchanged.
+private func expectConsistentLayout(_ diagnostics: PackagingDiagnosticsCxx) {
+    let text = Array(diagnostics.text)
+    for (index, record) in diagnostics.diagnostics.enumerated() {
+        let end = Int(record.messageOffset) + Int(record.messageLength)
+        #expect(end < text.count)
+        guard end < text.count else { continue }
+        #expect(text[end] == 0)
+        let bytes = text[Int(record.messageOffset)..<end].map { UInt8(bitPattern: $0) }
+        #expect(String(decoding: bytes, as: UTF8.self) == String(diagnostics.GetMessage(Int32(index))))
+        #expect(diagnostics.GetSeverity(Int32(index)) == record.severity)
+    }
+    for (index, offset) in diagnostics.failedAssetPathOffsets.enumerated() {
+        let start = Int(offset)
+        let end = text[start...].firstIndex(of: 0)
+        #expect(end != nil)
+        guard let end else { continue }
+        let bytes = text[start..<end].map { UInt8(bitPattern: $0) }
+        #expect(String(decoding: bytes, as: UTF8.self) == String(diagnostics.GetFailedAssetPath(Int32(index))))
+    }
+}
+
+@Test func nativePackagingDiagnosticsNameTheMissingTexture() throws {
+    let directory = try makeTemporaryDirectory("diagnostics")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let source = directory.appending(path: "broken.usda")
+    try """
+    #usda 1.0
+
+    def Shader "Texture"
+    {
+        asset inputs:file = @./missing.png@
+    }
+    """.write(to: source, atomically: true, encoding: .utf8)
+
+    let summary = CreateUsdzPackageNativeDetailed(
+        std.string(source.path), std.string(directory.appending(path: "broken.usdz").path)
+    )
+    let diagnostics = GetPackagingDiagnostics()
+    #expect(diagnostics.GetDiagnosticCount() == summary.diagnosticCount)
+    #expect(diagnostics.GetFailedAssetCount() == summary.failedAssetCount)
+    let messages = (0..<diagnostics.GetDiagnosticCount()).map { String(diagnostics.GetMessage($0)) }
+    #expect(messages.contains { $0.contains("missing.png") })
+    // The bulk copy agrees with the index-based accessors.
+    for index in 0..<diagnostics.GetDiagnosticCount() {
+        #expect(String(GetPackagingDiagnosticMessage(index)) == messages[Int(index)])
+        #expect(GetPackagingDiagnosticSeverity(index) == diagnostics.GetSeverity(index))
+    }
+    expectConsistentLayout(diagnostics)
+    ClearPackagingDiagnosticCache()
+    #expect(GetPackagingDiagnostics().GetDiagnosticCount() == 0)
+}
+
+@Test func pipelinedPackagingReportsItsOwnWriteFailure() throws {
+    let directory = try makeTemporaryDirectory("diagnostics")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let source = directory.appending(path: "box.usda")
+    try cubeLayer(size: 2).write(to: source, atomically: true, encoding: .utf8)
+    let output = directory.appending(path: "absent/box.usdz").path
+
+    let summary = CreateUsdzPackagePipelined(std.string(source.path), std.string(output), nil, nil)
+    #expect(!summary.success)
+    let diagnostics = GetPackagingDiagnostics()
+    #expect(diagnostics.GetDiagnosticCount() == 1)
+    #expect(String(diagnostics.GetMessage(0)) == "Failed to open '\(output)' for writing")
+    #expect(diagnostics.GetSeverity(0) == 2)
+    #expect(diagnostics.GetFailedAssetCount() == 0)
+    #expect(summary.errorCount == 1)
+    expectConsistentLayout(diagnostics)
+}
+
+/// The dependency cache is process-wide, so these run one at a time.
+@Suite(.serialized) struct DependencyCacheTests {
+    private func writeRoot(at url: URL, dependencies: [String]) throws {
+        let references = dependencies.map { "@./\($0)@" }.joined(separator: ", ")
+        try """
+        #usda 1.0
+
+        def Xform "Root" (
+            prepend references = [\(references)]
+        )
+        {
+            def Shader "Texture"
+            {
+                asset inputs:file = @./albedo.png@
+            }
+        }
+        """.write(to: url, atomically: true, encoding: .utf8)
+    }
+
+    private func unresolvedCount(_ url: URL) -> Int {
+        let report = CheckDependenciesReport(std.string(url.path))
+        return report.success ? Int(report.GetUnresolvedCount()) : -1
+    }
+
+    @Test func layerEditIsPickedUp() throws {
+        let directory = try makeTemporaryDirectory("dependencies")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let root = directory.appending(path: "root.usda")
+        try cubeLayer(size: 2).write(to: directory.appending(path: "box.usda"), atomically: true, encoding: .utf8)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+
+        try writeRoot(at: root, dependencies: ["box.usda"])
+        #expect(unresolvedCount(root) == 0)
+
+        try writeRoot(at: root, dependencies: ["box.usda", "missing.usda"])
+        #expect(unresolvedCount(root) == 1)
+    }
+
+    @Test func editIsPickedUpWhileAStageHoldsTheLayer() throws {
+        let directory = try makeTemporaryDirectory("dependencies")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let root = directory.appending(path: "root.usda")
+        try cubeLayer(size: 2).write(to: directory.appending(path: "box.usda"), atomically: true, encoding: .utf8)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+        try writeRoot(at: root, dependencies: ["box.usda"])
+
+        // The open stage keeps the pre-edit root layer in the registry.
+        let stage = try #require(USDInteropStageHandle(url: root))
+        #expect(unresolvedCount(root) == 0)
+        try writeRoot(at: root, dependencies: ["box.usda", "missing.usda"])
+        #expect(unresolvedCount(root) == 1)
+        withExtendedLifetime(stage) {}
+    }
+
+    @Test func auditSharesDependenciesAcrossAssets() throws {
+        let directory = try makeTemporaryDirectory("audit")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        try cubeLayer(size: 2).write(to: directory.appending(path: "shared.usda"), atomically: true, encoding: .utf8)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+        let first = directory.appending(path: "a.usda")
+        let second = directory.appending(path: "b.usda")
+        try writeRoot(at: first, dependencies: ["shared.usda"])
+        try writeRoot(at: second, dependencies: ["shared.usda", "missing.usda"])
+
+        var paths = DependencyAuditPathListCxx()
+        paths.push_back(std.string(first.path))
+        paths.push_back(std.string(second.path))
+        let report = AuditDependencies(paths)
+        let dependencies = Array(report.dependencies)
+        let names = dependencies.map { URL(filePath: String($0.path)).lastPathComponent }
+        // Each distinct dependency is listed once, however many assets use it.
+        #expect(names.sorted() == ["albedo.png", "missing.usda", "shared.usda"])
+        let count = { (name: String) in
+            dependencies[try #require(names.firstIndex(of: name))].assetCount
+        }
+        #expect(try count("shared.usda") == 2)
+        #expect(try count("albedo.png") == 2)
+        #expect(try count("missing.usda") == 1)
+        let missing = try #require(names.firstIndex(of: "missing.usda"))
+        #expect(dependencies[missing].kind == Int32(DependencyKindUnresolved.rawValue))
+
+        let assets = Array(report.assets)
+        #expect(assets.count == 2)
+        #expect(assets[0].success)
+        #expect(Array(assets[0].dependencyIndices).count == 2)
+        #expect(Array(assets[0].unresolvedIndices).isEmpty)
+        #expect(Array(assets[1].unresolvedIndices) == [Int32(missing)])
+        #expect(report.GetFailedAssetCount() == 1)
+        #expect(String(report.GetUnresolvedPath(1, 0)).hasSuffix("missing.usda"))
+
+        // The directory form audits every layer in path order, the shared
+        // layer included, and agrees on the shared dependency table.
+        let scanned = AuditDependenciesInDirectory(std.string(directory.path))
+        let scannedAssets = Array(scanned.assets).map { URL(filePath: String($0.assetPath)).lastPathComponent }
+        #expect(scannedAssets == ["a.usda", "b.usda", "shared.usda"])
+        #expect(scanned.dependencies.count == report.dependencies.count)
+        #expect(scanned.GetFailedAssetCount() == 1)
+        #expect(Array(Array(scanned.assets)[2].dependencyIndices).isEmpty)
+    }
+
+    @Test func addingMissingAssetClearsUnresolved() throws {
+        let directory = try makeTemporaryDirectory("dependencies")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let root = directory.appending(path: "root.usda")
+        try writeRoot(at: root, dependencies: [])
+
+        // The root layer is unchanged between checks; only the texture appears.
+        #expect(unresolvedCount(root) == 1)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+        #expect(unresolvedCount(root) == 0)
+    }
+
+    @Test func cacheFileRoundTrips() throws {
+        let directory = try makeTemporaryDirectory("dependencies")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let root = directory.appending(path: "root.usda")
+        let cacheFile = directory.appending(path: "dependencies.cache")
+        try cubeLayer(size: 2).write(to: directory.appending(path: "box.usda"), atomically: true, encoding: .utf8)
+        try writeRoot(at: root, dependencies: ["box.usda"])
+
+        #expect(SetDependencyCacheFile(std.string(cacheFile.path)))
+        defer { _ = SetDependencyCacheFile(std.string()) }
+        #expect(unresolvedCount(root) == 1)
+
+        let saved = try String(contentsOf: cacheFile, encoding: .utf8)
+        #expect(saved.hasPrefix("usdinterop-dependency-cache "))
+        #expect(saved.contains("box.usda"))
+
+        // A cache rebuilt from the file gives the same answer, and still sees
+        // the texture once it exists.
+        ClearDependencyCache()
+        #expect(SetDependencyCacheFile(std.string(cacheFile.path)))
+        #expect(unresolvedCount(root) == 1)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+        #expect(unresolvedCount(root) == 0)
+    }
+
+    @Test func packagedDependenciesResolveInsidePackage() throws {
+        let directory = try makeTemporaryDirectory("dependencies")
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let root = directory.appending(path: "root.usda")
+        let package = directory.appending(path: "root.usdz")
+        try cubeLayer(size: 2).write(to: directory.appending(path: "box.usda"), atomically: true, encoding: .utf8)
+        try Data("png".utf8).write(to: directory.appending(path: "albedo.png"))
+        try writeRoot(at: root, dependencies: ["box.usda"])
+
+        let packaged = CreateUsdzPackagePipelinedReport(
+            std.string(root.path), std.string(package.path), nil, nil
+        )
+        try #require(packaged.summary.success)
+
+        // Only the package exists now, so every dependency must be anchored
+        // inside it.
+        try FileManager.default.removeItem(at: root)
+        try FileManager.default.removeItem(at: directory.appending(path: "box.usda"))
+        try FileManager.default.removeItem(at: directory.appending(path: "albedo.png"))
+        #expect(unresolvedCount(package) == 0)
+    }
+}
+
+private func makeTemporaryStage(_ name: String, _ contents: String) throws -> URL {
+    let url = URL(filePath: NSTemporaryDirectory())
+        .appending(path: "usdinterop-\(name)-\(UUID().uuidString).usda")
+    try contents.write(to: url, atomically: true, encoding: .utf8)
+    return url
+}
+
+/// Triangles and vertices of every mesh from `usdinterop_extract_meshes`,
+/// with indices made absolute.
+private struct ExtractedMeshes {
+    var positions: [SIMD3<Float>] = []
+    var normals: [SIMD3<Float>] = []
+    var triangles: [(Int, Int, Int)] = []
+    var flags: [Int] = []
+
+    init?(stage: USDInteropStageHandle) {
+        let buffers = usdinterop_extract_meshes(stage.pointer, nil, nil)
+        defer { usdinterop_free_mesh_buffers(buffers) }
+        guard buffers.meshCount > 0,
+            let meshes = buffers.meshes,
+            let positions = buffers.positions,
+            let normals = buffers.normals,
+            let indices = buffers.indices
+        else {
+            return nil
+        }
+        for vertex in 0..<Int(buffers.vertexCount) {
+            self.positions.append(SIMD3(positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]))
+            self.normals.append(SIMD3(normals[vertex * 3], normals[vertex * 3 + 1], normals[vertex * 3 + 2]))
+        }
+        for index in 0..<Int(buffers.meshCount) {
+            let mesh = meshes[index]
+            let base = Int(mesh.firstVertex)
+            let first = Int(mesh.firstIndex)
+            for triangle in stride(from: first, to: first + Int(mesh.indexCount), by: 3) {
+                triangles.append((
+                    base + Int(indices[triangle]),
+                    base + Int(indices[triangle + 1]),
+                    base + Int(indices[triangle + 2])
+                ))
+            }
+            flags.append(Int(mesh.flags))
+        }
+    }
+
+    /// Normal implied by a triangle's counter-clockwise winding.
+    func windingNormal(_ triangle: (Int, Int, Int)) -> SIMD3<Float> {
+        let a = positions[triangle.0], b = positions[triangle.1], c = positions[triangle.2]
+        let e1 = b - a, e2 = c - a
+        return SIMD3(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x)
+    }
+}
+
+private func quadStage(orientation: String = "rightHanded", scale: String = "(1, 1, 1)") -> String {
+    """
+    #usda 1.0
+
+    def Xform "Root"
+    {
+        float3 xformOp:scale = \(scale)
+        uniform token[] xformOpOrder = ["xformOp:scale"]
+
+        def Mesh "Quad"
+        {
+            int[] faceVertexCounts = [4]
+            int[] faceVertexIndices = [0, 1, 2, 3]
+            uniform token orientation = "\(orientation)"
+            point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)]
+        }
+    }
+    """
+}
+
+@Test func extractedQuadIsTwoCounterClockwiseTriangles() throws {
+    let url = try makeTemporaryStage("quad", quadStage())
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let meshes = try #require(ExtractedMeshes(stage: stage))
+
+    #expect(meshes.triangles.count == 2)
+    #expect(meshes.flags == [Int(USDINTEROP_MESH_COMPUTED_NORMALS)])
+    for triangle in meshes.triangles {
+        #expect(meshes.windingNormal(triangle).z > 0)
+    }
+    for normal in meshes.normals {
+        #expect(normal == SIMD3(0, 0, 1))
+    }
+}
+
+@Test(arguments: [
+    ("leftHanded", "(1, 1, 1)", Float(-1)),
+    ("rightHanded", "(-1, 1, 1)", Float(1)),
+    ("leftHanded", "(-1, 1, 1)", Float(-1)),
+])
+func extractedWindingFollowsOrientationAndMirroring(
+    orientation: String, scale: String, expectedZ: Float
+) throws {
+    let url = try makeTemporaryStage("quad", quadStage(orientation: orientation, scale: scale))
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let meshes = try #require(ExtractedMeshes(stage: stage))
+
+    // Triangles stay counter-clockwise about the normals they are given.
+    #expect(meshes.triangles.count == 2)
+    for triangle in meshes.triangles {
+        #expect(meshes.windingNormal(triangle).z * expectedZ > 0)
+    }
+    for normal in meshes.normals {
+        #expect(normal == SIMD3(0, 0, expectedZ))
+    }
+}
+
+@Test func computedNormalsPointOutOfClosedMesh() throws {
+    let url = try makeTemporaryStage("cube", """
+    #usda 1.0
+
+    def Xform "Root"
+    {
+        double3 xformOp:translate = (10, 0, 0)
+        uniform token[] xformOpOrder = ["xformOp:translate"]
+
+        def Mesh "Cube"
+        {
+            int[] faceVertexCounts = [4, 4, 4, 4, 4, 4]
+            int[] faceVertexIndices = [0, 3, 2, 1, 4, 5, 6, 7, 0, 1, 5, 4, 3, 7, 6, 2, 0, 4, 7, 3, 1, 2, 6, 5]
+            point3f[] points = [(-1, -1, -1), (1, -1, -1), (1, 1, -1), (-1, 1, -1), (-1, -1, 1), (1, -1, 1), (1, 1, 1), (-1, 1, 1)]
+        }
+    }
+    """)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let meshes = try #require(ExtractedMeshes(stage: stage))
+
+    let center = SIMD3<Float>(10, 0, 0)
+    #expect(meshes.triangles.count == 12)
+    for (position, normal) in zip(meshes.positions, meshes.normals) {
+        let outward = position - center
+        #expect((outward * normal).sum() > 0)
+    }
+    for triangle in meshes.triangles {
+        let centroid = (meshes.positions[triangle.0] + meshes.positions[triangle.1] + meshes.positions[triangle.2]) / 3
+        #expect(((centroid - center) * meshes.windingNormal(triangle)).sum() > 0)
+    }
+}
+
+/// A small scene shared by the stage query tests.
+private let sceneFixture = """
+#usda 1.0
+(
+    defaultPrim = "Root"
+    startTimeCode = 0
+    endTimeCode = 10
+)
+
+def Xform "Root" (
+    kind = "component"
+)
+{
+    double3 xformOp:translate.timeSamples = {
+        0: (0, 0, 0),
+        10: (10, 0, 0),
+    }
+    uniform token[] xformOpOrder = ["xformOp:translate"]
+
+    def Cube "Box"
+    {
+        double size = 2
+    }
+
+    def Sphere "Ball" (
+        prepend apiSchemas = ["MaterialBindingAPI"]
+    )
+    {
+        double radius = 1
+    }
+
+    def Mesh "Tri"
+    {
+        int[] faceVertexCounts = [3]
+        int[] faceVertexIndices = [0, 1, 2]
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]
+        texCoord2f[] primvars:st = [(0, 0), (1, 0)] (
+            interpolation = "vertex"
+        )
+        int[] primvars:st:indices = [0, 1, 1]
+    }
+
+    def Camera "Camera"
+    {
+    }
+}
+"""
+
+@Test func streamedSceneGraphJSONMatchesDocument() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    var streamed = Data()
+    #expect(stage.writeSceneGraphJSON { chunk in
+        streamed.append(contentsOf: chunk)
+        return true
+    })
+    #expect(String(decoding: streamed, as: UTF8.self) == stage.sceneGraphJSON())
+
+    let prims = try #require(try JSONSerialization.jsonObject(with: streamed) as? [[String: Any]])
+    #expect(prims.count == 1)
+    #expect(prims.first?["path"] as? String == "/Root")
+    #expect((prims.first?["children"] as? [Any])?.count == 4)
+
+    // A sink that asks to stop is not called again.
+    var calls = 0
+    #expect(stage.writeSceneGraphJSON { _ in
+        calls += 1
+        return false
+    } == false)
+    #expect(calls == 1)
+}
+
+@Test func binarySceneGraphLinksPrimsInOrder() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let graph = try #require(stage.sceneGraph())
+
+    #expect(graph.primCount == 5)
+    #expect(graph.rootIndices.count == 1)
+    let root = try #require(graph.rootIndices.first)
+    #expect(graph.name(of: root) == "Root")
+    #expect(graph.typeName(of: root) == "Xform")
+    #expect(graph.parentIndex(of: root) == nil)
+
+    var children: [(name: String, type: String?)] = []
+    var child = graph.firstChildIndex(of: root)
+    while let index = child {
+        #expect(graph.parentIndex(of: index) == root)
+        #expect(graph.firstChildIndex(of: index) == nil)
+        children.append((graph.name(of: index), graph.typeName(of: index)))
+        child = graph.nextSiblingIndex(of: index)
+    }
+    #expect(children.map(\.name) == ["Box", "Ball", "Tri", "Camera"])
+    #expect(children.map(\.type) == ["Cube", "Sphere", "Mesh", "Camera"])
+}
+
+@Test func sceneGraphChildrenArePaged() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    let json = try #require(stage.sceneGraphChildrenJSON(primPath: "/Root", offset: 1, limit: 2))
+    let page = try #require(try JSONSerialization.jsonObject(with: Data(json.utf8)) as? [String: Any])
+    #expect(page["path"] as? String == "/Root")
+    #expect(page["childCount"] as? Int == 4)
+    #expect(page["offset"] as? Int == 1)
+    let children = try #require(page["children"] as? [[String: Any]])
+    #expect(children.compactMap { $0["name"] as? String } == ["Ball", "Tri"])
+    // Past the requested depth, nodes report their child count only.
+    #expect(children.allSatisfy { $0["childCount"] as? Int == 0 && $0["children"] == nil })
+
+    let deeper = try #require(stage.sceneGraphChildrenJSON(primPath: "/", depth: 2))
+    let root = try #require(try JSONSerialization.jsonObject(with: Data(deeper.utf8)) as? [String: Any])
+    let top = try #require((root["children"] as? [[String: Any]])?.first)
+    #expect((top["children"] as? [Any])?.count == 4)
+
+    #expect(USDInteropStage.sceneGraphChildrenJSON(url: url, primPath: "/Root", offset: 1, limit: 2) == json)
+    #expect(stage.sceneGraphChildrenJSON(primPath: "/Missing") == nil)
+}
+
+@Test func arrayViewsShareAttributeData() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    let points = try #require(USDInteropArray(stage: stage, attributePath: "/Root/Tri.points"))
+    #expect(points.count == 3)
+    #expect(points.elementType == USDINTEROP_ARRAY_VEC3F)
+    #expect(points.withUnsafeBufferPointer(as: SIMD3<Float>.self) { _ in true } == nil)
+    let xs = points.withUnsafeBufferPointer(as: (Float, Float, Float).self) { buffer in
+        buffer.map(\.0)
+    }
+    #expect(xs == [0, 1, 0])
+
+    let indices = try #require(USDInteropArray(stage: stage, attributePath: "/Root/Tri.faceVertexIndices"))
+    #expect(indices.withUnsafeBufferPointer(as: Int32.self) { Array($0) } == [0, 1, 2])
+
+    // Token arrays are not numeric, and missing attributes have no array.
+    #expect(USDInteropArray(stage: stage, attributePath: "/Root.xformOpOrder") == nil)
+    #expect(USDInteropArray(stage: stage, attributePath: "/Root/Tri.missing") == nil)
+
+    let st = try #require(USDInteropArray.primvar(stage: stage, primPath: "/Root/Tri", name: "st"))
+    #expect(st.values.count == 2)
+    #expect(st.values.elementType == USDINTEROP_ARRAY_VEC2F)
+    #expect(st.indices?.withUnsafeBufferPointer(as: Int32.self) { Array($0) } == [0, 1, 1])
+}
+
+@Test func attributeSamplesCoverFrameRange() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    let samples = try #require(stage.sampleAttributes(
+        ["/Root.xformOp:translate", "/Root/Box.size", "/Root.missing"],
+        start: 0,
+        end: 10,
+        stride: 5
+    ))
+    #expect(samples.times == [0, 5, 10])
+    #expect(samples.componentCounts == [3, 1, 0])
+    #expect(samples.columns[0] == [0, 0, 0, 5, 0, 0, 10, 0, 0])
+    #expect(samples.columns[1] == [2, 2, 2])
+    #expect(samples.columns[2].isEmpty)
+
+    // A non-positive stride samples the start time only.
+    #expect(stage.sampleAttributes(["/Root/Box.size"], start: 3, end: 10, stride: 0)?.times == [3])
+}
+
+@Test func attributeSamplingRejectsUnboundedRanges() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    #expect(stage.sampleAttributes(["/Root/Box.size"], start: 0, end: .infinity) == nil)
+    #expect(stage.sampleAttributes(["/Root/Box.size"], start: 0, end: 10, stride: .nan) == nil)
+    #expect(stage.sampleAttributes(["/Root/Box.size"], start: 0, end: 1e12, stride: 1) == nil)
+}
+
+@Test func fastBoundsPreferAuthoredDataOverPayloads() throws {
+    let directory = try makeTemporaryDirectory("fast-bounds")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let root = directory.appending(path: "root.usda")
+    try cubeLayer(size: 2).write(
+        to: directory.appending(path: "heavy.usda"), atomically: true, encoding: .utf8
+    )
+    try """
+    #usda 1.0
+    (
+        defaultPrim = "World"
+    )
+
+    def Xform "World" (
+        kind = "assembly"
+    )
+    {
+        def Xform "Hinted" (
+            kind = "component"
+            payload = @./heavy.usda@
+        )
+        {
+            float3[] extentsHint = [(-1, -1, -1), (1, 1, 1)]
+        }
+
+        def Cube "Boxed" (
+            payload = @./heavy.usda@
+        )
+        {
+            float3[] extent = [(-1, -1, -1), (1, 1, 1)]
+            double3 xformOp:translate = (10, 0, 0)
+            uniform token[] xformOpOrder = ["xformOp:translate"]
+        }
+
+        def Xform "Loose" (
+            payload = @./heavy.usda@
+        )
+        {
+            double3 xformOp:translate = (20, 0, 0)
+            uniform token[] xformOpOrder = ["xformOp:translate"]
+        }
+
+        def Sphere "Computed"
+        {
+            double3 xformOp:translate = (30, 0, 0)
+            uniform token[] xformOpOrder = ["xformOp:translate"]
+        }
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+
+    // The unloaded cube has an authored extent, so only the payload under
+    // "Loose" is loaded; contributions from loaded payloads come last.
+    let stage = try #require(USDInteropStageHandle(url: root, loadSet: .none))
+    let (bounds, contributions) = stage.fastBounds()
+    #expect(contributions.map(\.primPath) == [
+        "/World/Hinted", "/World/Boxed", "/World/Computed", "/World/Loose",
+    ])
+    #expect(contributions.map(\.strategy) == [
+        .extentsHint, .authoredExtent, .computedExtent, .loadedPayload,
+    ])
+    let loose = try #require(contributions.last)
+    #expect(loose.min == SIMD3(19, -1, -1))
+    #expect(loose.max == SIMD3(21, 1, 1))
+    let framed = try #require(bounds)
+    #expect(framed.min == SIMD3(-1, -1, -1))
+    #expect(framed.max == SIMD3(31, 1, 1))
+
+    let (pathBounds, strategies) = try #require(USDInteropStage.fastSceneBounds(url: root))
+    #expect(pathBounds.min == framed.min)
+    #expect(pathBounds.max == framed.max)
+    #expect(strategies == [.extentsHint, .authoredExtent, .computedExtent, .loadedPayload])
+}
+
+@Test func boundsBatchIsTimeMajorWithEmptyBoxesForInvalidPrims() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+
+    let paths = ["/Root/Box", "/Root/Missing", "", "Root/Box", "/Root/Camera"]
+    let bounds = try #require(stage.bounds(primPaths: paths, timeCodes: [0, 10]))
+    #expect(bounds.count == 2 * paths.count * 6)
+
+    let empty: [Float] = [.greatestFiniteMagnitude, .greatestFiniteMagnitude, .greatestFiniteMagnitude,
+                          -.greatestFiniteMagnitude, -.greatestFiniteMagnitude, -.greatestFiniteMagnitude]
+    let entry = { (time: Int, prim: Int) in
+        Array(bounds[((time * paths.count + prim) * 6)..<((time * paths.count + prim) * 6 + 6)])
+    }
+    #expect(entry(0, 0) == [-1, -1, -1, 1, 1, 1])
+    #expect(entry(1, 0) == [9, -1, -1, 11, 1, 1])
+    for time in 0..<2 {
+        // Missing, empty and relative paths, and a camera with no extent.
+        for prim in 1..<paths.count {
+            #expect(entry(time, prim) == empty)
+        }
+    }
+    #expect(stage.bounds(primPaths: [], timeCodes: [0]) == [])
+}
+
+@Test func stageStatisticsCountSceneContents() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let statistics = try #require(stage.statistics())
+
+    #expect(statistics.primCount == 5)
+    #expect(statistics.meshCount == 1)
+    #expect(statistics.meshPointCount == 3)
+    #expect(statistics.meshFaceCount == 1)
+    #expect(statistics.meshFaceVertexCount == 3)
+    #expect(statistics.meshPrimvarCount == 1)
+    #expect(statistics.materialCount == 0)
+    #expect(statistics.cameraPaths == ["/Root/Camera"])
+    #expect(statistics.animationPaths.isEmpty)
+    #expect(statistics.layerCount >= 1)
+    #expect(statistics.layerByteEstimate > 0)
+    #expect(statistics.typeCounts.count == 5)
+    #expect(statistics.typeCounts.allSatisfy { $0.count == 1 })
+}
+
+@Test func stageStatisticsWithoutOptionsListPathsInTraversalOrder() throws {
+    // Deep and wide enough to be split into parallel subtrees, with children
+    // authored in reverse name order.
+    let groups = (0..<4).reversed().map { group in
+        let shots = (0..<40).reversed().map { shot in
+            """
+                def Xform "Shot\(shot)"
+                {
+                    def Camera "Cam"
+                    {
+                    }
+
+                    def Mesh "Set"
+                    {
+                        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]
+                    }
+                }
+            """
+        }.joined(separator: "\n")
+        return "def Xform \"Group\(group)\"\n{\n\(shots)\n}"
+    }.joined(separator: "\n\n")
+    let url = try makeTemporaryStage("statistics", "#usda 1.0\n\n\(groups)\n")
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let paths = try #require(stage.statistics(options: []))
+
+    let expected = (0..<4).reversed().flatMap { group in
+        (0..<40).reversed().map { "/Group\(group)/Shot\($0)/Cam" }
+    }
+    #expect(paths.cameraPaths == expected)
+    #expect(paths.primCount == 4 + 4 * 40 * 3)
+    #expect(paths.meshCount == 0)
+    #expect(paths.meshPointCount == 0)
+    #expect(paths.layerCount == 0)
+    #expect(paths.layerByteEstimate == 0)
+
+    let full = try #require(stage.statistics())
+    #expect(full.cameraPaths == expected)
+    #expect(full.primCount == paths.primCount)
+    #expect(full.meshCount == 4 * 40)
+    #expect(full.meshPointCount == 4 * 40 * 3)
+}
+
+@Test func primIndexAnswersQueriesAndFollowsReloads() throws {
+    let url = try makeTemporaryStage("scene", sceneFixture)
+    defer { try? FileManager.default.removeItem(at: url) }
+    let stage = try #require(USDInteropStageHandle(url: url))
+    let index = try #require(USDInteropPrimIndex(stage: stage))
+
+    #expect(index.prims(ofType: "Gprim") == ["/Root/Ball", "/Root/Box", "/Root/Tri"])
+    #expect(index.prims(ofType: "Camera") == ["/Root/Camera"])
+    #expect(index.prims(ofKind: "component") == ["/Root"])
+    #expect(index.prims(withAPISchema: "MaterialBindingAPI") == ["/Root/Ball"])
+    #expect(index.prims(namePrefix: "b") == ["/Root/Ball", "/Root/Box"])
+    #expect(index.prims(namePrefix: "B", limit: 1) == ["/Root/Ball"])
+    #expect(index.prims(ofType: "NoSuchType").isEmpty)
+
+    // A reload resyncs the stage; the index picks up the new prim without
+    // being rebuilt.
+    let edited = sceneFixture.replacingOccurrences(
+        of: "def Camera \"Camera\"",
+        with: "def Cube \"Crate\"\n    {\n    }\n\n    def Camera \"Camera\""
+    )
+    try edited.write(to: url, atomically: true, encoding: .utf8)
+    #expect((stage.refresh() ?? 0) > 0)
+    #expect(index.prims(namePrefix: "c") == ["/Root/Camera", "/Root/Crate"])
+    #expect(index.prims(ofType: "Cube") == ["/Root/Box", "/Root/Crate"])
+}
+
+@Test func sourceSitesBatchListsOpinionsStrongestFirst() throws {
+    let directory = try makeTemporaryDirectory("sites")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let root = directory.appending(path: "root.usda")
+    try """
+    #usda 1.0
+
+    def Xform "Root"
+    {
+        def Cube "Box"
+        {
+            double size = 2
+        }
+    }
+    """.write(to: directory.appending(path: "base.usda"), atomically: true, encoding: .utf8)
+    try """
+    #usda 1.0
+    (
+        subLayers = [@./base.usda@]
+    )
+
+    over "Root"
+    {
+        over "Box"
+        {
+            double size = 4
+        }
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+    let stage = try #require(USDInteropStageHandle(url: root))
+
+    let sites = stage.sourceSites(paths: ["/Root/Box", "/Root/Box.size", "/Root/Missing", "not a path"])
+    #expect(sites.count == 4)
+    for opinions in sites.prefix(2) {
+        #expect(opinions.count == 2)
+        #expect(opinions.map(\.role) == [0, 1])
+        #expect(opinions.compactMap { $0.layerRealPath.map { URL(filePath: $0).lastPathComponent } }
+            == ["root.usda", "base.usda"])
+    }
+    #expect(sites[0].map(\.specPath) == ["/Root/Box", "/Root/Box"])
+    #expect(sites[1].map(\.specPath) == ["/Root/Box.size", "/Root/Box.size"])
+    #expect(sites[2].isEmpty)
+    #expect(sites[3].isEmpty)
+}
+
+private func attributeEdit(
+    _ path: String,
+    _ type: USDInteropCxx.USDInterop.AttributeEditTypeCxx,
+    _ values: (Float, Float, Float) = (0, 0, 0)
+) -> USDInteropCxx.USDInterop.AttributeEditCxx {
+    var edit = USDInteropCxx.USDInterop.AttributeEditCxx()
+    edit.attributePath = pxr.SdfPath(std.string(path))
+    edit.type = Int32(type.rawValue)
+    edit.floatValues = values
+    edit.timeCode = pxr.UsdTimeCode.Default()
+    return edit
+}
+
+@Test func attributeEditsApplyAsOneBatch() throws {
+    let directory = try makeTemporaryDirectory("edits")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let root = directory.appending(path: "root.usda")
+    try """
+    #usda 1.0
+
+    over "Root"
+    {
+        float fromBase = 1
+    }
+    """.write(to: directory.appending(path: "base.usda"), atomically: true, encoding: .utf8)
+    try """
+    #usda 1.0
+    (
+        subLayers = [@./base.usda@]
+    )
+
+    def Xform "Root"
+    {
+        float opacity = 1
+        color3f tint = (1, 1, 1)
+        string label = "crate"
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+
+    let stage = USDInteropOpenUSDShim.dereferenceStage(
+        pxr.UsdStage.Open(std.string(root.path), .LoadAll)
+    )
+    var edits = USDInteropCxx.USDInterop.AttributeEditListCxx()
+    edits.push_back(attributeEdit("/Root.opacity", USDInteropCxx.USDInterop.AttributeEditFloat, (0.5, 0, 0)))
+    edits.push_back(attributeEdit("/Root.missing", USDInteropCxx.USDInterop.AttributeEditFloat, (2, 0, 0)))
+    edits.push_back(attributeEdit("/Root.opacity", USDInteropCxx.USDInterop.AttributeEditColor3f, (1, 0, 0)))
+    edits.push_back(attributeEdit("/Root.tint", USDInteropCxx.USDInterop.AttributeEditColor3f, (0.25, 0.5, 0.75)))
+    // Authored only in the sublayer, so the edit target has no spec for it
+    // until the change block creates one.
+    edits.push_back(attributeEdit("/Root.fromBase", USDInteropCxx.USDInterop.AttributeEditFloat, (7, 0, 0)))
+    edits.push_back(attributeEdit("/Root.label", USDInteropCxx.USDInterop.AttributeEditBlock))
+
+    var statuses: [UInt8] = []
+    let notices = USDInteropOpenUSDShim.countObjectsChanged(stage) {
+        statuses = USDInteropOpenUSDShim.applyAttributeEdits(stage, edits)
+    }
+    #expect(notices == 1)
+    #expect(statuses == [
+        UInt8(USDInteropCxx.USDInterop.AttributeEditApplied.rawValue),
+        UInt8(USDInteropCxx.USDInterop.AttributeEditMissingAttribute.rawValue),
+        UInt8(USDInteropCxx.USDInterop.AttributeEditInvalidType.rawValue),
+        UInt8(USDInteropCxx.USDInterop.AttributeEditApplied.rawValue),
+        UInt8(USDInteropCxx.USDInterop.AttributeEditApplied.rawValue),
+        UInt8(USDInteropCxx.USDInterop.AttributeEditApplied.rawValue),
+    ])
+
+    var exported = std.string()
+    _ = USDInteropOpenUSDShim.dereferenceLayer(stage.GetRootLayer()).ExportToString(&exported)
+    let text = String(exported)
+    #expect(text.contains("float opacity = 0.5"))
+    #expect(text.contains("color3f tint = (0.25, 0.5, 0.75)"))
+    #expect(text.contains("float fromBase = 7"))
+    #expect(text.contains("string label = None"))
+    #expect(!text.contains("missing"))
+}
+
+@Test func tokenSpecRewriteCoversSublayersOnce() throws {
+    let directory = try makeTemporaryDirectory("rewrite")
+    defer { try? FileManager.default.removeItem(at: directory) }
+    let base = directory.appending(path: "base.usda")
+    let root = directory.appending(path: "root.usda")
+    try """
+    #usda 1.0
+
+    def Xform "Root"
+    {
+        custom uniform token kind = "hero"
+        token tag
+    }
+    """.write(to: base, atomically: true, encoding: .utf8)
+    try """
+    #usda 1.0
+    (
+        subLayers = [@./base.usda@]
+    )
+
+    over "Root"
+    {
+        token tag = "v1"
+        token other = "keep"
+    }
+    """.write(to: root, atomically: true, encoding: .utf8)
+
+    let stage = USDInteropOpenUSDShim.dereferenceStage(
+        pxr.UsdStage.Open(std.string(root.path), .LoadAll)
+    )
+    // The root layer is listed twice; its specs must be counted once.
+    var layers = stage.GetLayerStack(true)
+    layers.push_back(stage.GetRootLayer())
+    var names = USDInteropCxx.USDInterop.PropertyNameListCxx()
+    names.push_back(std.string("kind"))
+    names.push_back(std.string("tag"))
+
+    let planned = USDInteropCxx.USDInterop.RewriteTokenAttributeSpecsToString(layers, names, true)
+    #expect(planned == 3)
+    #expect(USDInteropCxx.USDInterop.RewriteTokenAttributeSpecsToString(layers, names, false) == planned)
+    #expect(USDInteropCxx.USDInterop.RewriteTokenAttributeSpecsToString(stage, names, true) == 0)
+
+    var exported = std.string()
+    _ = USDInteropOpenUSDShim.dereferenceLayer(stage.GetRootLayer()).ExportToString(&exported)
+    let rootText = String(exported)
+    #expect(rootText.contains("string tag = \"v1\""))
+    #expect(rootText.contains("token other = \"keep\""))
+
+    let baseLayer = try #require(layers.first {
+        String(USDInteropOpenUSDShim.dereferenceLayer($0).GetRealPath()).hasSuffix("base.usda")
+    })
+    exported = std.string()
+    _ = USDInteropOpenUSDShim.dereferenceLayer(baseLayer).ExportToString(&exported)
+    let baseText = String(exported)
+    // Variability, the custom flag and the default value survive the rewrite.
+    #expect(baseText.contains("custom uniform string kind = \"hero\""))
+    #expect(baseText.contains("string tag"))
+    #expect(!baseText.contains("token"))
+}
+
+/// A 1000-byte file and a package storing a copy of it as `texture.png`.
+private struct AssetFixture {
+    let directory: URL
+    let file: URL
+    let package: URL
+    let bytes = Data((0..<1000).map { UInt8($0 % 251) })
+
+    var packagedEntry: String { "\(package.path)[texture.png]" }
+
+    init(_ name: String) throws {
+        directory = try makeTemporaryDirectory(name)
+        file = directory.appending(path: "texture.png")
+        package = directory.appending(path: "textured.usdz")
+        try bytes.write(to: file)
+        let root = directory.appending(path: "textured.usda")
+        try """
+        #usda 1.0
+
+        def Shader "Texture"
+        {
+            asset inputs:file = @./texture.png@
+        }
+        """.write(to: root, atomically: true, encoding: .utf8)
+        let packaged = CreateUsdzPackagePipelinedReport(
+            std.string(root.path), std.string(package.path), nil, nil
+        )
+        try #require(packaged.summary.success)
+    }
+}
+
+@Test func assetHandlesExposeFileAndPackagedBytes() throws {
+    let fixture = try AssetFixture("assets")
+    defer { try? FileManager.default.removeItem(at: fixture.directory) }
+
+    for path in [fixture.file.path, fixture.packagedEntry] {
+        let asset = try #require(USDInteropAsset(assetPath: path))
+        #expect(asset.size == fixture.bytes.count)
+        #expect(asset.data == fixture.bytes)
+    }
+    let anchored = try #require(USDInteropAsset(
+        assetPath: "./texture.png",
+        anchorAssetPath: fixture.directory.appending(path: "textured.usda").path
+    ))
+    #expect(anchored.data == fixture.bytes)
+    #expect(USDInteropAsset(assetPath: fixture.directory.appending(path: "missing.png").path) == nil)
+    // Data outlives the handle it came from.
+    let data = USDInteropAssets.readData(assetPath: fixture.packagedEntry)
+    #expect(data == fixture.bytes)
+}
+
+@Test func assetRangeReadsClampToTheEnd() throws {
+    let fixture = try AssetFixture("assets")
+    defer { try? FileManager.default.removeItem(at: fixture.directory) }
+
+    for path in [fixture.file.path, fixture.packagedEntry] {
+        let asset = try #require(USDInteropAsset(assetPath: path))
+        #expect(asset.read(offset: 0, length: 8) == fixture.bytes.prefix(8))
+        #expect(asset.read(offset: 100, length: 50) == fixture.bytes[100..<150])
+        #expect(asset.read(offset: 990, length: 100) == fixture.bytes.suffix(10))
+        #expect(asset.read(offset: 1000, length: 4).isEmpty)
+        #expect(asset.read(offset: 5000, length: 4).isEmpty)
+    }
+}
+
+@Test func assetChunkedReadsTrackTheirPosition() throws {
+    let fixture = try AssetFixture("assets")
+    defer { try? FileManager.default.removeItem(at: fixture.directory) }
+
+    for path in [fixture.file.path, fixture.packagedEntry] {
+        let asset = try #require(USDInteropAsset(assetPath: path))
+        var buffer = [UInt8](repeating: 0, count: 300)
+        usdinterop_asset_seek(asset.pointer, 500)
+        #expect(usdinterop_asset_tell(asset.pointer) == 500)
+        #expect(usdinterop_asset_read_next(asset.pointer, &buffer, 300) == 300)
+        #expect(Data(buffer) == fixture.bytes[500..<800])
+        #expect(usdinterop_asset_tell(asset.pointer) == 800)
+        #expect(usdinterop_asset_read_next(asset.pointer, &buffer, 300) == 200)
+        #expect(Data(buffer.prefix(200)) == fixture.bytes.suffix(200))
+        #expect(usdinterop_asset_read_next(asset.pointer, &buffer, 300) == 0)
+        #expect(usdinterop_asset_tell(asset.pointer) == 1000)
+        // Seeking past the end stops at the end.
+        usdinterop_asset_seek(asset.pointer, 5000)
+        #expect(usdinterop_asset_tell(asset.pointer) == 1000)
+
+        var chunks = Data()
+        var chunkCount = 0
+        asset.forEachChunk(chunkSize: 128) { chunk in
+            chunks.append(contentsOf: chunk)
+            chunkCount += 1
+            return true
+        }
+        #expect(chunks == fixture.bytes)
+        #expect(chunkCount == 8)
+    }
+}
+
+@Test func assetBatchesMatchSingleOpens() throws {
+    let fixture = try AssetFixture("assets")
+    defer { try? FileManager.default.removeItem(at: fixture.directory) }
+    let other = try makeTemporaryDirectory("assets-other")
+    defer { try? FileManager.default.removeItem(at: other) }
+    let otherBytes = Data("other root".utf8)
+    try otherBytes.write(to: other.appending(path: "other.bin"))
+
+    // Without an anchor each path resolves under its own context, so paths
+    // from different roots and packages mix freely.
+    let unanchored = [
+        fixture.file.path,
+        other.appending(path: "other.bin").path,
+        fixture.packagedEntry,
+        other.appending(path: "missing.bin").path,
+    ]
+    let opened = USDInteropAssets.open(assetPaths: unanchored)
+    #expect(opened.map { $0?.data } == [fixture.bytes, otherBytes, fixture.bytes, nil])
+    for (path, asset) in zip(unanchored, opened) {
+        #expect(asset?.data == USDInteropAsset(assetPath: path)?.data)
+    }
+
+    let anchor = fixture.directory.appending(path: "textured.usda").path
+    let anchoredPaths = ["./texture.png", "./textured.usdz[texture.png]", "./missing.png"]
+    let anchored = USDInteropAssets.open(assetPaths: anchoredPaths, anchorAssetPath: anchor)
+    #expect(anchored.map { $0?.data } == [fixture.bytes, fixture.bytes, nil])
+}
+
+@Test func resolveBatchLinesUpWithItsInput() throws {
+    let fixture = try AssetFixture("assets")
+    defer { try? FileManager.default.removeItem(at: fixture.directory) }
+    let anchor = fixture.directory.appending(path: "textured.usda").path
+
+    let anchored = USDInteropAssets.resolve(
+        assetPaths: ["./texture.png", "./missing.png", "./textured.usdz"],
+        anchorAssetPath: anchor
+    )
+    #expect(anchored.count == 3)
+    #expect(anchored[0].map { URL(filePath: $0).standardizedFileURL } == fixture.file.standardizedFileURL)
+    #expect(anchored[1] == nil)
+    #expect(anchored[2].map { URL(filePath: $0).standardizedFileURL } == fixture.package.standardizedFileURL)
+
+    let unanchored = USDInteropAssets.resolve(
+        assetPaths: [fixture.file.path, fixture.directory.appending(path: "missing.png").path]
+    )
+    #expect(unanchored.count == 2)
+    #expect(unanchored[0] != nil)
+    #expect(unanchored[1] == nil)
+    #expect(USDInteropAssets.resolve(assetPaths: []).isEmpty)
+}